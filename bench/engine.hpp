@@ -0,0 +1,88 @@
+#ifndef ISAAC_BENCH_ENGINE_HPP
+#define ISAAC_BENCH_ENGINE_HPP
+
+#include "isaac/physics/physics_2d.hpp"
+#include "isaac/render/window_server.hpp"
+#include "isaac/scene/scene_manager.hpp"
+#include "isaac/system/event_bus.hpp"
+#include "isaac/system/input.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/service_locator.hpp"
+#include "isaac/system/thread.hpp"
+#include "isaac/system/world.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace isaac::bench {
+
+// Headless services registered the same way Isaac does, plus an empty scene.
+// Services are global, so only one Engine may be alive at a time.
+class Engine
+{
+  std::unique_ptr<Logger> m_logger;
+  std::unique_ptr<WindowServer> m_window_server;
+  std::unique_ptr<PhysicsServer2D> m_physics_server;
+  std::unique_ptr<SceneManager> m_scene_manager;
+  std::unique_ptr<Input> m_input;
+  std::unique_ptr<EventBus> m_event_bus;
+  std::unique_ptr<JobSystem> m_jobs;
+  std::unique_ptr<World> m_world;
+
+ public:
+  explicit Engine(std::size_t physics_workers = 1,
+                  std::size_t job_workers     = 1)
+      : m_logger{ServiceLocator<Logger>::register_service(Logger::ERROR)}
+      , m_window_server{ServiceLocator<WindowServer>::register_service(
+            headless)}
+      , m_physics_server{ServiceLocator<PhysicsServer2D>::register_service(
+            physics_workers)}
+      , m_scene_manager{ServiceLocator<SceneManager>::register_service()}
+      , m_input{ServiceLocator<Input>::register_service()}
+      , m_event_bus{ServiceLocator<EventBus>::register_service()}
+      , m_jobs{ServiceLocator<JobSystem>::register_service(job_workers)}
+  {
+    m_scene_manager->set_scene(std::make_unique<Scene>());
+    m_world = std::make_unique<World>(*m_window_server, *m_scene_manager,
+                                      *m_physics_server);
+    m_world->start();
+  }
+
+  GameObject& root()
+  {
+    return m_scene_manager->get_current_scene()->root();
+  }
+
+  PhysicsServer2D& physics()
+  {
+    return *m_physics_server;
+  }
+
+  JobSystem& jobs()
+  {
+    return *m_jobs;
+  }
+
+  sf::RenderWindow& window()
+  {
+    return m_window_server->get_window();
+  }
+
+  void tick(std::size_t ticks = 1)
+  {
+    m_world->game_loop(ticks);
+  }
+
+  // runs the game loop in batches of ticks until the benchmark is done
+  void run(benchmark::State& state, benchmark::IterationCount batch = 64)
+  {
+    while (state.KeepRunningBatch(batch)) {
+      m_world->game_loop(static_cast<std::size_t>(batch));
+    }
+  }
+};
+
+} // namespace isaac::bench
+#endif
@@ -0,0 +1,231 @@
+#include "engine.hpp"
+
+#include "isaac/components/component_pool.hpp"
+#include "isaac/components/game_object.hpp"
+#include "isaac/components/game_object_pool.hpp"
+#include "isaac/components/shape_renderer.hpp"
+#include "isaac/physics/transform.hpp"
+
+#include <SFML/Graphics/CircleShape.hpp>
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace isaac;
+
+// most objects in a scene carry a shape
+class Node : public GameObject
+{
+  void on_start() override
+  {
+    auto& renderer = make_component<ShapeRenderer>();
+    renderer.make_shape<sf::CircleShape>(4.f);
+  }
+};
+
+// destroys all its children and spawns as many new ones every update
+class Churner : public GameObject
+{
+  std::size_t m_count;
+
+  void on_update(float) override
+  {
+    for (auto const& child : std::as_const(*this).get_children()) {
+      child->destroy();
+    }
+    for (std::size_t i = 0; i < m_count; ++i) {
+      make_child<Node>();
+    }
+  }
+
+ public:
+  explicit Churner(std::size_t count)
+      : m_count{count}
+  {}
+};
+
+// the same churn, recycling the nodes through a GameObjectPool
+class PooledChurner : public GameObject
+{
+  std::size_t m_count;
+  GameObjectPool<Node> m_pool{*this};
+  std::vector<Node*> m_alive;
+
+  void on_update(float) override
+  {
+    for (auto const node : m_alive) {
+      m_pool.release(*node);
+    }
+    m_alive.clear();
+    for (std::size_t i = 0; i < m_count; ++i) {
+      m_alive.push_back(&m_pool.acquire());
+    }
+  }
+
+ public:
+  explicit PooledChurner(std::size_t count)
+      : m_count{count}
+  {}
+};
+
+// adds count nodes below root, breadth first, fanout children per node
+void make_tree(GameObject& root, std::size_t count, std::size_t fanout)
+{
+  std::vector<GameObject*> parents{&root};
+  std::size_t made = 0;
+  for (std::size_t p = 0; made < count; ++p) {
+    for (std::size_t c = 0; c < fanout && made < count; ++c, ++made) {
+      parents.push_back(&parents[p]->make_child<Node>());
+    }
+  }
+}
+
+void BM_GameObjectUpdate(benchmark::State& state)
+{
+  auto const count  = static_cast<std::size_t>(state.range(0));
+  auto const fanout = static_cast<std::size_t>(state.range(1));
+  bench::Engine engine;
+  make_tree(engine.root(), count, fanout);
+  engine.run(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GameObjectUpdate)
+    ->Args({1 << 10, 4})
+    ->Args({1 << 14, 4})
+    ->Args({1 << 14, 64});
+
+// CPU side of drawing: stale checks and appending cached geometry to the
+// shared batch. Submitting it needs a GL context, so the batch is discarded.
+void BM_ShapeRendererDraw(benchmark::State& state)
+{
+  if constexpr (!k_component_pools) {
+    state.SkipWithError("requires ISAAC_COMPONENT_POOLS");
+    return;
+  }
+  bench::Engine engine;
+  make_tree(engine.root(), static_cast<std::size_t>(state.range(0)), 8);
+  auto& pool = ComponentPool<ShapeRenderer>::instance();
+  for (auto _ : state) {
+    pool.draw(engine.window());
+    ShapeRenderer::batch().clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ShapeRendererDraw)->Arg(1 << 10)->Arg(1 << 14);
+
+// moves every update when asked to, dragging its whole subtree along
+class Mover : public GameObject
+{
+  bool m_moving;
+  float m_x = 0.f;
+
+  void on_update(float) override
+  {
+    if (m_moving) {
+      set_position({m_x += 1.f, 0.f});
+    }
+  }
+
+ public:
+  explicit Mover(bool moving)
+      : m_moving{moving}
+  {}
+};
+
+// a tick over a subtree that moves as a whole, or stays put like level
+// geometry, in which case its transforms are never recomputed
+void BM_TransformPropagation(benchmark::State& state)
+{
+  bench::Engine engine;
+  auto& top = engine.root().make_child<Mover>(state.range(1) != 0);
+  make_tree(top, static_cast<std::size_t>(state.range(0)), 4);
+  engine.run(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformPropagation)
+    ->Args({1 << 10, 0})
+    ->Args({1 << 10, 1})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 14, 1});
+
+// one level of the hierarchy composed with its parents' world matrices
+void BM_ComposeMatrices(benchmark::State& state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  MatrixArray parents;
+  MatrixArray locals;
+  MatrixArray worlds;
+  parents.resize(count);
+  locals.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const f = static_cast<float>(i);
+    parents.set(i, Matrix2D::from({f, f}, sf::degrees(f), {1.f, 1.f}));
+    locals.set(i, Matrix2D::from({1.f, f}, sf::degrees(-f), {2.f, 1.f}));
+  }
+  for (auto _ : state) {
+    compose(parents, locals, worlds);
+    benchmark::DoNotOptimize(worlds.tx.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ComposeMatrices)->Arg(1 << 10)->Arg(1 << 16);
+
+void BM_DestroyQueuedChurn(benchmark::State& state)
+{
+  bench::Engine engine;
+  engine.root().make_child<Churner>(static_cast<std::size_t>(state.range(0)));
+  engine.run(state, 16);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DestroyQueuedChurn)->Arg(64)->Arg(1 << 10);
+
+void BM_PooledChurn(benchmark::State& state)
+{
+  bench::Engine engine;
+  engine.root().make_child<PooledChurner>(
+      static_cast<std::size_t>(state.range(0)));
+  engine.run(state, 16);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PooledChurn)->Arg(64)->Arg(1 << 10);
+
+
+// CPU bound update, steering itself from a few thousand flops per step
+class Cruncher : public GameObject
+{
+  float m_phase = 0.f;
+
+  void on_parallel_update(float delta) override
+  {
+    auto x = get_position().x;
+    for (int i = 0; i < 2048; ++i) {
+      x = std::sin(x + m_phase) * 0.5f;
+    }
+    m_phase += delta;
+    set_position({x, 0.f});
+  }
+
+ public:
+  Cruncher()
+  {
+    set_parallel_update(true);
+  }
+};
+
+void BM_ParallelUpdate(benchmark::State& state)
+{
+  bench::Engine engine{1, static_cast<std::size_t>(state.range(0))};
+  for (int i = 0; i < 256; ++i) {
+    engine.root().make_child<Cruncher>();
+  }
+  engine.run(state, 16);
+  state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_ParallelUpdate)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+} // namespace
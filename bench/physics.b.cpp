@@ -0,0 +1,147 @@
+#include "engine.hpp"
+
+#include "isaac/components/collision_object_2d.hpp"
+#include "isaac/components/game_object.hpp"
+#include "isaac/components/rigidbody_2d.hpp"
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/debug_draw_2d.hpp"
+#include "isaac/physics/query_2d.hpp"
+
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using namespace isaac;
+
+constexpr float k_radius  = 4.f;
+constexpr float k_spacing = 10.f;
+constexpr int k_columns   = 64;
+
+class Ball : public GameObject
+{
+  void on_start() override
+  {
+    auto& body = make_component<RigidBody2D>(Circle2DShape{k_radius});
+    body.set_restitution(0.f);
+  }
+
+ public:
+  // bodies are placed where their object is when started
+  explicit Ball(sf::Vector2f position)
+  {
+    set_position(position);
+  }
+};
+
+class Wall : public GameObject
+{
+ public:
+  explicit Wall(sf::Vector2f size)
+  {
+    make_component<CollisionObject2D>(Box2DShape{size});
+  }
+};
+
+// an open box with count balls stacked in a grid above its floor
+void make_pile(GameObject& root, int count)
+{
+  auto const rows   = count / k_columns + 1;
+  auto const width  = k_columns * k_spacing + 2 * k_spacing;
+  auto const height = rows * k_spacing * 2;
+  root.make_child<Wall>(sf::Vector2f{width, k_spacing})
+      .set_position({0.f, height});
+  root.make_child<Wall>(sf::Vector2f{k_spacing, height})
+      .set_position({0.f, 0.f});
+  root.make_child<Wall>(sf::Vector2f{k_spacing, height})
+      .set_position({width - k_spacing, 0.f});
+  for (int i = 0; i < count; ++i) {
+    auto const x = k_spacing + (i % k_columns) * k_spacing;
+    auto const y = (i / k_columns) * k_spacing;
+    root.make_child<Ball>(sf::Vector2f{x, y});
+  }
+}
+
+// one PhysicsServer2D step, including the move and contact event dispatch.
+// The pile settles and starts sleeping, as it would in a game.
+void BM_PhysicsStep(benchmark::State& state)
+{
+  auto const count   = static_cast<int>(state.range(0));
+  auto const workers = static_cast<std::size_t>(state.range(1));
+  bench::Engine engine{workers};
+  make_pile(engine.root(), count);
+  // static bodies follow their objects on the first world step
+  engine.tick();
+  for (auto _ : state) {
+    engine.physics().update(1.f / 60.f);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PhysicsStep)
+    ->Args({1 << 10, 1})
+    ->Args({1 << 12, 1})
+    ->Args({1 << 12, 4})
+    ->Unit(benchmark::kMicrosecond);
+
+// a batch of rays swept down across the settled pile, as targeting code
+// would issue them, over 1 to 4 job workers
+void BM_RaycastBatch(benchmark::State& state)
+{
+  auto const count   = static_cast<int>(state.range(0));
+  auto const workers = static_cast<std::size_t>(state.range(1));
+  bench::Engine engine{1, workers};
+  make_pile(engine.root(), 1 << 12);
+  engine.tick(60);
+  std::vector<Ray2D> rays;
+  auto const width = k_columns * k_spacing;
+  for (int i = 0; i < count; ++i) {
+    auto const x = k_spacing + width * static_cast<float>(i) / count;
+    rays.push_back({{x, -100.f}, {0.f, 2000.f}});
+  }
+  std::vector<CastHit2D> hits(rays.size());
+  for (auto _ : state) {
+    engine.physics().raycast(rays, hits, b2DefaultQueryFilter(),
+                             &engine.jobs());
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RaycastBatch)
+    ->Args({1 << 12, 1})
+    ->Args({1 << 12, 4})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// CPU side of the physics debug overlay over a settled pile, seen whole or
+// through an 800x600 view. Submitting needs a GL context, so the batch is
+// discarded.
+void BM_DebugDraw(benchmark::State& state)
+{
+  auto const count = static_cast<int>(state.range(0));
+  bench::Engine engine;
+  make_pile(engine.root(), count);
+  engine.tick(60);
+  auto const width  = k_columns * k_spacing + 2 * k_spacing;
+  auto const height = (count / k_columns + 1) * k_spacing * 2;
+  sf::View const view =
+      state.range(1) != 0
+          ? sf::View{sf::FloatRect{{0.f, height - 600.f}, {800.f, 600.f}}}
+          : sf::View{sf::FloatRect{{0.f, 0.f}, {width, height}}};
+  DebugDraw2D batch;
+  for (auto _ : state) {
+    engine.physics().debug_draw(batch, view);
+    benchmark::DoNotOptimize(batch.vertex_count());
+    batch.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DebugDraw)
+    ->Args({10000, 0})
+    ->Args({10000, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,256 @@
+#include "isaac/system/binary_logger.hpp"
+#include "isaac/system/event_bus.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/observer.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace isaac;
+
+struct Event
+{
+  int value;
+};
+
+class Counter : public Observer<Event>
+{
+ public:
+  int total = 0;
+
+  void on_notify(Observable<Event>&, Event const& event) override
+  {
+    total += event.value;
+  }
+};
+
+void BM_ObservableNotify(benchmark::State& state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  std::vector<Counter> counters(count);
+  Observable<Event> subject;
+  for (auto& counter : counters) {
+    subject.add_observer(counter);
+  }
+  for (auto _ : state) {
+    subject.notify({1});
+  }
+  benchmark::DoNotOptimize(counters.front().total);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ObservableNotify)->Arg(1)->Arg(16)->Arg(1 << 10);
+
+class Sink : public Observer<Event>
+{
+ public:
+  void on_notify(Observable<Event>&, Event const& event) override
+  {
+    benchmark::DoNotOptimize(event.value);
+  }
+};
+
+// notify from several threads at once, each call walks the snapshot
+// without taking a lock
+void BM_ObservableNotifyThreads(benchmark::State& state)
+{
+  static std::vector<Sink> sinks(16);
+  static Observable<Event> subject;
+  if (state.thread_index() == 0) {
+    for (auto& sink : sinks) {
+      subject.add_observer(sink);
+    }
+  }
+  for (auto _ : state) {
+    subject.notify({0});
+  }
+  state.SetItemsProcessed(state.iterations() * 16);
+}
+BENCHMARK(BM_ObservableNotifyThreads)->ThreadRange(1, 8);
+
+struct Receiver
+{
+  int total = 0;
+
+  void on_event(Event const& event)
+  {
+    total += event.value;
+  }
+};
+
+// a frame of queued events delivered to 16 subscribers
+void BM_EventBusDrain(benchmark::State& state)
+{
+  auto const events = static_cast<int>(state.range(0));
+  std::vector<Receiver> receivers(16);
+  EventBus bus;
+  bus.reserve<Event>(static_cast<std::size_t>(events));
+  for (auto& receiver : receivers) {
+    bus.subscribe<&Receiver::on_event>(receiver);
+  }
+  for (auto _ : state) {
+    for (int i = 0; i < events; ++i) {
+      bus.publish(Event{1});
+    }
+    bus.drain();
+  }
+  benchmark::DoNotOptimize(receivers.front().total);
+  // deliveries, comparable with BM_ObservableNotify
+  state.SetItemsProcessed(state.iterations() * events
+                          * static_cast<int>(receivers.size()));
+}
+BENCHMARK(BM_EventBusDrain)->Arg(1)->Arg(1 << 10)->Arg(1 << 14);
+
+// swallows whatever the logger writes so the terminal is not measured
+class NullBuffer : public std::streambuf
+{
+ protected:
+  int_type overflow(int_type c) override
+  {
+    return c;
+  }
+  std::streamsize xsputn(char const*, std::streamsize count) override
+  {
+    return count;
+  }
+};
+
+// exposes the timestamp formatting to the benchmarks
+class TimestampLogger : public Logger
+{
+ public:
+  using LoggerService::get_current_time;
+};
+
+void BM_CurrentTime(benchmark::State& state)
+{
+  TimestampLogger logger;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(logger.get_current_time());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CurrentTime);
+
+// the formatting get_current_time did for every message before it cached
+// the text of the current second, kept as a baseline
+void BM_CurrentTimeUncached(benchmark::State& state)
+{
+  std::string const fmt = "%Y-%m-%d %H:%M:%S";
+  for (auto _ : state) {
+    auto const now = std::chrono::system_clock::now();
+    auto t         = std::chrono::system_clock::to_time_t(now);
+    std::tm l_time{};
+    localtime_r(&t, &l_time);
+    std::stringstream ss{};
+    ss << std::put_time(&l_time, fmt.c_str());
+    benchmark::DoNotOptimize(ss.str());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CurrentTimeUncached);
+
+void BM_LoggerInfo(benchmark::State& state)
+{
+  NullBuffer null_buffer;
+  auto* const stderr_buffer = std::cerr.rdbuf(&null_buffer);
+  Logger logger{Logger::INFO};
+  for (auto _ : state) {
+    logger.info("player spawned at (120, 48)");
+  }
+  std::cerr.rdbuf(stderr_buffer);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoggerInfo);
+
+// cost on the calling thread, the writer thread drops what it cannot keep
+// up with
+void BM_AsyncLoggerInfo(benchmark::State& state)
+{
+  NullBuffer null_buffer;
+  auto* const stderr_buffer = std::cerr.rdbuf(&null_buffer);
+  {
+    AsyncLogger logger{Logger::INFO};
+    for (auto _ : state) {
+      logger.info("player spawned at (120, 48)");
+    }
+    state.counters["dropped"] = static_cast<double>(logger.dropped());
+  }
+  std::cerr.rdbuf(stderr_buffer);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLoggerInfo);
+
+// a message below the logger level, which should cost next to nothing
+void BM_LoggerFiltered(benchmark::State& state)
+{
+  Logger logger{Logger::INFO};
+  for (auto _ : state) {
+    logger.debug("player spawned at (120, 48)");
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoggerFiltered);
+
+// same through the macro, the arguments are never formatted
+void BM_LogMacroFiltered(benchmark::State& state)
+{
+  Logger logger{Logger::INFO};
+  float x = 120.f;
+  for (auto _ : state) {
+    ISAAC_LOG_DEBUG(logger, "player spawned at ({}, {})", x, 48.f);
+    benchmark::DoNotOptimize(x);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogMacroFiltered);
+
+// formatted text through the macro, the baseline for the binary sink
+void BM_LogMacroInfo(benchmark::State& state)
+{
+  NullBuffer null_buffer;
+  auto* const stderr_buffer = std::cerr.rdbuf(&null_buffer);
+  Logger logger{Logger::INFO};
+  float x = 120.f;
+  for (auto _ : state) {
+    ISAAC_LOG_INFO(logger, "player spawned at ({}, {})", x, 48.f);
+    benchmark::DoNotOptimize(x);
+  }
+  std::cerr.rdbuf(stderr_buffer);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogMacroInfo);
+
+// the arguments are copied into the mapped file, nothing is formatted.
+// iterations are fixed so every message fits in the default capacity
+void BM_BinaryLoggerInfo(benchmark::State& state)
+{
+  auto const path =
+      std::filesystem::temp_directory_path() / "isaac_bench_log.bin";
+  std::filesystem::remove(path);
+  {
+    BinaryLogger logger{path};
+    float x = 120.f;
+    for (auto _ : state) {
+      ISAAC_LOG_INFO(logger, "player spawned at ({}, {})", x, 48.f);
+      benchmark::DoNotOptimize(x);
+    }
+    state.counters["dropped"] = static_cast<double>(logger.dropped());
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinaryLoggerInfo)->Iterations(1 << 20);
+
+} // namespace
@@ -4,7 +4,8 @@
 #include "particle.hpp"
 
 #include <isaac/components/game_object.hpp>
-#include <isaac/system/observer.hpp>
+#include <isaac/system/event_bus.hpp>
+#include <isaac/system/service_locator.hpp>
 #include <imgui.h>
 
 enum class HudEventType
@@ -19,16 +20,26 @@ struct HudEvent
   float value;
 };
 
-class Hud
-    : public isaac::GameObject
-    , public isaac::Observer<ParticleEvent>
-    , public isaac::Observable<HudEvent>
+class Hud : public isaac::GameObject
 {
+  isaac::EventBus& m_events =
+      *isaac::ServiceLocator<isaac::EventBus>::get_service();
+
   int m_counter       = 0;
   float m_spawn_rate  = 1.f;
   float m_restitution = 0.f;
 
  public:
+  Hud()
+  {
+    m_events.subscribe<&Hud::on_particle_spawned>(*this);
+  }
+
+  ~Hud() override
+  {
+    m_events.unsubscribe_all(this);
+  }
+
   void on_draw(sf::RenderWindow&) override
   {
     float spawn_rate  = m_spawn_rate;
@@ -43,18 +54,17 @@ class Hud
     if (std::abs(spawn_rate - m_spawn_rate) > 0.01f) {
       m_spawn_rate = spawn_rate;
       HudEvent event{HudEventType::SPAWN_RATE_CHANGED, m_spawn_rate};
-      notify(event);
+      m_events.publish(event);
     }
 
     if (std::abs(restitution - m_restitution) > 0.01f) {
       m_restitution = restitution;
       HudEvent event{HudEventType::RESTITUTION_CHANGED, m_restitution};
-      notify(event);
+      m_events.publish(event);
     }
   };
 
-  void on_notify(isaac::Observable<ParticleEvent>& subject,
-                 ParticleEvent const& event) override
+  void on_particle_spawned(ParticleEvent const&)
   {
     ++m_counter;
   }
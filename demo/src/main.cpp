@@ -1,7 +1,11 @@
 #include <isaac/isaac.hpp>
 #include <isaac/scene/scene.hpp>
+#include <isaac/system/profiler.hpp>
+#include <isaac/system/trace.hpp>
 
+#include <cstdlib>
 #include <memory>
+#include <string_view>
 
 #include "hud.hpp"
 #include "obstacles.hpp"
@@ -18,17 +22,31 @@ class MainScene : public isaac::Scene
     // root.make_child<Player>();
     root.make_child<Walls>();
     root.make_child<Obstacles>();
-    auto& hud     = root.make_child<Hud>();
-    auto& spawner = root.make_child<Spawner>();
-    spawner.add_observer(hud);
-    hud.add_observer(spawner);
+    root.make_child<Hud>();
+    root.make_child<Spawner>();
   }
 };
 
-int main()
+int main(int argc, char* argv[])
 {
+  // ISAAC_TRACE=<file> records a Chrome trace, written when the demo exits
+  if (auto const trace = std::getenv("ISAAC_TRACE")) {
+    isaac::Tracer::instance().start(trace);
+  }
+
+  // isaac-demo --headless [ticks] runs the simulation without a window
+  if (argc > 1 && std::string_view{argv[1]} == "--headless") {
+    auto const ticks = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+    isaac::Isaac isaac{isaac::headless, isaac::Logger::Level::DEBUG};
+    isaac.set_scene(std::make_unique<MainScene>());
+    return isaac.run(ticks);
+  }
+
   isaac::Isaac isaac{"Isaac Demo", {800, 600}, isaac::Logger::Level::DEBUG};
   isaac.set_scene(std::make_unique<MainScene>());
+  // shows the Profiler window next to the Inspector
+  isaac::Profiler::set_enabled(true);
+  isaac.set_physics_debug_draw(true);
   isaac.run();
   return 0;
 }
@@ -11,7 +11,7 @@
 
 class Orbiter : public isaac::GameObject
 {
-  isaac::GameObject* m_attractor;
+  isaac::Handle<isaac::GameObject> m_attractor;
 
  private:
   void on_start() override
@@ -39,13 +39,13 @@ class Orbiter : public isaac::GameObject
   void on_destroy() override
   {
     auto logger = isaac::ServiceLocator<isaac::Logger>::get_service();
-    logger->info("Orbiter destroyed!");
+    ISAAC_LOG_INFO(*logger, "Orbiter destroyed!");
   }
 
  public:
   void set_attractor(isaac::GameObject& attractor)
   {
-    m_attractor = &attractor;
+    m_attractor = attractor;
   }
 };
 
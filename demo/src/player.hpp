@@ -54,7 +54,7 @@ class Player : public isaac::GameObject
   void on_collision_2d(isaac::Collision2D const& collision) override
   {
     auto logger = isaac::ServiceLocator<isaac::Logger>::get_service();
-    logger->info("There was a collision!");
+    ISAAC_LOG_INFO(*logger, "There was a collision!");
     // if (collision.other->game_object()) {
     //   collision.other->game_object()->destroy();
     // }
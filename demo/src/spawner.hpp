@@ -5,13 +5,23 @@
 #include "particle.hpp"
 
 #include <isaac/components/game_object.hpp>
-#include <isaac/system/observer.hpp>
+#include <isaac/components/game_object_pool.hpp>
+#include <isaac/system/event_bus.hpp>
+#include <isaac/system/service_locator.hpp>
 
-class Spawner
-    : public isaac::GameObject
-    , public isaac::Observable<ParticleEvent>
-    , public isaac::Observer<HudEvent>
+#include <cstddef>
+#include <deque>
+
+class Spawner : public isaac::GameObject
 {
+  // particles alive at once, the oldest is recycled past this
+  static constexpr std::size_t k_max_particles = 256;
+
+  isaac::EventBus& m_events =
+      *isaac::ServiceLocator<isaac::EventBus>::get_service();
+  isaac::GameObjectPool<Particle> m_particles{*this};
+  std::deque<isaac::Handle<Particle>> m_alive;
+
   float m_elapsed{};
   float m_spawn_interval = 1.f;
   float m_restitution    = 0.f;
@@ -32,13 +42,19 @@ class Spawner
 
   void spawn()
   {
-    auto& child = make_child<Particle>();
-    child.get_rigid_body()->set_restitution(m_restitution);
-    notify({});
+    if (m_alive.size() == k_max_particles) {
+      if (auto const oldest = m_alive.front().get()) {
+        m_particles.release(*oldest);
+      }
+      m_alive.pop_front();
+    }
+    auto& particle = m_particles.acquire();
+    particle.get_rigid_body()->set_restitution(m_restitution);
+    m_alive.emplace_back(particle);
+    m_events.publish(ParticleEvent{});
   }
 
-  void on_notify(isaac::Observable<HudEvent>& subject,
-                 HudEvent const& event) override
+  void on_hud_event(HudEvent const& event)
   {
     if (event.type == HudEventType::SPAWN_RATE_CHANGED) {
       m_spawn_interval = 1.0f / event.value;
@@ -46,6 +62,17 @@ class Spawner
       m_restitution = event.value;
     }
   }
+
+ public:
+  Spawner()
+  {
+    m_events.subscribe<&Spawner::on_hud_event>(*this);
+  }
+
+  ~Spawner() override
+  {
+    m_events.unsubscribe_all(this);
+  }
 };
 
 #endif // ISAAC_DEMO_SPAWNER_HPP
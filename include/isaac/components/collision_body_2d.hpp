@@ -10,6 +10,8 @@
 
 namespace isaac {
 
+class PhysicsServer2D;
+
 class CollisionBody2D : public Component
 {
  protected:
@@ -18,10 +20,27 @@ class CollisionBody2D : public Component
   b2BodyId m_body_id;
   sf::Vector2f m_offset;
 
+ private:
+  // called by PhysicsServer2D for the bodies Box2D reports as moved
+  void sync_transform(b2Transform const& transform);
+  friend class PhysicsServer2D;
+
  public:
   explicit CollisionBody2D(CollisionShape collision_shape);
+  ~CollisionBody2D() override;
+
+  // the body userData holds the component handle, resolved through the
+  // ObjectRegistry so a stale body never yields a dangling pointer
+  static CollisionBody2D* from_user_data(void* user_data);
+
+  // parked bodies are disabled in Box2D, and moved where their object is
+  // before rejoining the world
+  void enable(GameObject& go) override;
+  void disable(GameObject& go) override;
 
   b2BodyDef const& body_def() const;
+  // where the body of go belongs, its shape offset rotated with it
+  b2Transform body_transform(GameObject const& go) const;
   sf::Vector2f const& shape_offset() const;
 };
 
@@ -3,6 +3,7 @@
 
 #include "isaac/components/collision_body_2d.hpp"
 #include "isaac/components/component.hpp"
+#include "isaac/components/component_pool.hpp"
 #include "isaac/components/game_object.hpp"
 #include "isaac/physics/collision_shape_2d.hpp"
 
@@ -20,6 +21,9 @@ class CollisionObject2D : public CollisionBody2D
   virtual void update(GameObject&) override;
 };
 
+template<>
+inline constexpr bool is_pooled_component<CollisionObject2D> = true;
+
 } // namespace isaac
 
 #endif
@@ -3,6 +3,9 @@
 
 #include "isaac/internal/base_object.hpp"
 
+#include <cstddef>
+#include <limits>
+
 namespace sf {
 class RenderWindow;
 }
@@ -10,11 +13,28 @@ class RenderWindow;
 namespace isaac {
 
 class GameObject;
+class Component;
+
+template<typename T>
+class ComponentPool;
+
+// Returns a component to the ComponentPool it comes from, or deletes it
+struct ComponentDeleter
+{
+  void (*release)(Component*) = nullptr;
+  void operator()(Component* component) const;
+};
 
 class Component : public BaseObject
 {
-  GameObject* m_parent;
+  static constexpr auto k_not_pooled = std::numeric_limits<std::size_t>::max();
+
+  GameObject* m_parent     = nullptr;
+  std::size_t m_pool_index = k_not_pooled;
+  bool m_active            = true;
   friend class GameObject;
+  template<typename T>
+  friend class ComponentPool;
 
  public:
   Component()                           = default;
@@ -24,9 +44,16 @@ class Component : public BaseObject
   virtual ~Component()                  = default;
 
   [[nodiscard]] GameObject* game_object();
+  // pooled components are updated by their pool, not by the GameObject
+  [[nodiscard]] bool pooled() const;
+  // false while its GameObject is disabled, pools skip inactive components
+  [[nodiscard]] bool active() const;
   virtual void start(GameObject& game_object) {};
   virtual void update(GameObject& game_object) {};
   virtual void draw(GameObject& game_object, sf::RenderWindow& window) {};
+  // called when the GameObject is enabled or disabled, with its ancestors
+  virtual void enable(GameObject& game_object) {};
+  virtual void disable(GameObject& game_object) {};
 };
 } // namespace isaac
 #endif
@@ -0,0 +1,133 @@
+#ifndef ISAAC_COMPONENTS_COMPONENT_POOL_HPP
+#define ISAAC_COMPONENTS_COMPONENT_POOL_HPP
+
+#include "isaac/components/component.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace sf {
+class RenderWindow;
+}
+
+namespace isaac {
+
+#ifdef ISAAC_COMPONENT_POOLS
+inline constexpr bool k_component_pools = true;
+#else
+inline constexpr bool k_component_pools = false;
+#endif
+
+// Specialised to true by the built-in components stored in a ComponentPool
+template<typename T>
+inline constexpr bool is_pooled_component = false;
+
+// Keeps every component of type T in fixed size chunks of contiguous memory.
+// Addresses are stable, so references returned by make_component stay valid,
+// and released slots are reused before a new chunk is allocated. update and
+// draw walk the slots in memory order calling T's members non-virtually.
+template<typename T>
+class ComponentPool
+{
+  static constexpr std::size_t k_chunk_size = 256;
+
+  struct Chunk
+  {
+    alignas(T) std::byte storage[sizeof(T) * k_chunk_size];
+  };
+
+  std::vector<std::unique_ptr<Chunk>> m_chunks;
+  std::vector<std::uint8_t> m_alive;
+  std::vector<std::size_t> m_free;
+  std::size_t m_size = 0;
+
+  T* slot(std::size_t index)
+  {
+    auto& chunk = *m_chunks[index / k_chunk_size];
+    return reinterpret_cast<T*>(chunk.storage) + index % k_chunk_size;
+  }
+
+  std::size_t allocate()
+  {
+    if (!m_free.empty()) {
+      auto const index = m_free.back();
+      m_free.pop_back();
+      return index;
+    }
+    if (m_alive.size() == m_chunks.size() * k_chunk_size) {
+      m_chunks.push_back(std::make_unique<Chunk>());
+    }
+    m_alive.push_back(0);
+    return m_alive.size() - 1;
+  }
+
+  // skips the components of disabled objects
+  template<typename F>
+  void for_each(F&& fn)
+  {
+    for (std::size_t i = 0; i < m_alive.size(); ++i) {
+      if (m_alive[i] && slot(i)->active()) {
+        fn(*slot(i));
+      }
+    }
+  }
+
+ public:
+  static ComponentPool& instance()
+  {
+    static ComponentPool pool;
+    return pool;
+  }
+
+  template<typename... Args>
+  T* create(Args&&... args)
+  {
+    auto const index = allocate();
+    T* component     = nullptr;
+    try {
+      component = std::construct_at(slot(index), std::forward<Args>(args)...);
+    } catch (...) {
+      m_free.push_back(index);
+      throw;
+    }
+    component->m_pool_index = index;
+    m_alive[index]          = 1;
+    ++m_size;
+    return component;
+  }
+
+  static void release(Component* component)
+  {
+    auto& pool       = instance();
+    auto const index = component->m_pool_index;
+    std::destroy_at(static_cast<T*>(component));
+    pool.m_alive[index] = 0;
+    pool.m_free.push_back(index);
+    --pool.m_size;
+  }
+
+  [[nodiscard]] std::size_t size() const
+  {
+    return m_size;
+  }
+
+  void update()
+  {
+    for_each([](T& component) {
+      component.T::update(*component.game_object());
+    });
+  }
+
+  void draw(sf::RenderWindow& window)
+  {
+    for_each([&](T& component) {
+      component.T::draw(*component.game_object(), window);
+    });
+  }
+};
+
+} // namespace isaac
+#endif
@@ -2,11 +2,12 @@
 #define ISAAC_COMPONENTS_GAME_OBJECT_HPP
 
 #include "isaac/components/component.hpp"
+#include "isaac/components/component_pool.hpp"
 #include "isaac/internal/base_object.hpp"
 #include "isaac/physics/transform.hpp"
 
 #include <cstddef>
-#include <unordered_set>
+#include <memory>
 #include <vector>
 
 namespace sf {
@@ -15,52 +16,106 @@ class RenderWindow;
 
 namespace isaac {
 
-class Collision2D;
+struct Collision2D;
 using GameObject_ptr = std::unique_ptr<GameObject>;
-using Component_ptr  = std::unique_ptr<Component>;
+using Component_ptr  = std::unique_ptr<Component, ComponentDeleter>;
 
 class GameObject : public BaseObject
 {
   Transform m_transform{};
-  bool m_enabled = false;
+  // the local transform changed since the last propagation, and a
+  // descendant's did; world matrices are refreshed by propagate_transform()
+  bool m_transform_dirty = false;
+  bool m_children_dirty  = false;
+  // on_parallel_update runs for this object, and for one of its descendants
+  bool m_parallel_update   = false;
+  bool m_parallel_children = false;
+  bool m_enabled           = true;
   std::vector<GameObject_ptr> m_children{};
   std::vector<Component_ptr> m_components{};
-  std::unordered_set<std::size_t> m_child_ids_to_erase{};
-  GameObject* m_parent = nullptr;
+  GameObject* m_parent  = nullptr;
+  bool m_destroy_queued = false;
+  bool m_compact_queued = false;
+  // cleared by the default on_draw, so objects drawing nothing of their own
+  // leave the shape batch going
+  bool m_custom_draw = true;
+
+  // objects whose destroy() was called since the last destroy_queued()
+  inline static std::vector<ObjectHandle> s_destroy_queue{};
 
  private:
   void start();
   void update(float delta);
-  void draw(sf::RenderWindow&);
-  void destroy_queued();
+  void update_parallel(float delta);
+  void save_transform();
+  void mark_transform_dirty();
+  void mark_parallel_update();
+  void propagate_transform();
+  void set_local_matrix();
+  void set_active(bool active);
+  void draw(sf::RenderWindow&, float alpha);
+  static void destroy_queued();
   [[nodiscard]] std::vector<GameObject_ptr>& get_children();
 
   friend class World;
-  friend class Collider2D;
+  friend class PhysicsServer2D;
 
  protected:
+  // hooks called on the main thread, free to use the whole engine
   virtual void on_start() {};
   virtual void on_update(float delta) {};
-  virtual void on_draw(sf::RenderWindow&) {};
+  // the shapes batched before an overriding on_draw are flushed first, so
+  // what it draws goes above them
+  virtual void on_draw(sf::RenderWindow&);
   virtual void on_destroy() {};
+  // the object starts or stops being updated, e.g. when recycled by a
+  // GameObjectPool; on_enable runs before its bodies rejoin the world
+  virtual void on_enable() {};
+  virtual void on_disable() {};
   virtual void on_collision_2d(Collision2D const& collision) {};
+  // Called on a job worker once set_parallel_update(true), every step after
+  // the physics update and before on_update. Top-level subtrees run
+  // concurrently, so it may only read and write this object and its
+  // descendants, set their transforms, log and run the read-only physics
+  // queries (raycast, shape_cast, overlap, without a JobSystem). Creating,
+  // destroying or enabling objects, components, physics bodies, the
+  // EventBus and other subtrees are off limits, as are profiler zones; trace
+  // zones are fine
+  virtual void on_parallel_update(float delta) {};
 
  public:
   GameObject()                            = default;
-  ~GameObject()                           = default;
+  virtual ~GameObject()                   = default;
   GameObject(GameObject const&)           = delete;
   GameObject(GameObject&&)                = default;
   GameObject operator=(GameObject const&) = delete;
 
+  // a disabled object and its subtree are neither updated nor drawn, and
+  // their physics bodies are taken out of the world
   void enable();
   void disable();
   [[nodiscard]] bool enabled() const;
+  // enabled along with all its ancestors
+  [[nodiscard]] bool active() const;
+  // from the main thread only
+  void set_parallel_update(bool enabled);
+  [[nodiscard]] bool parallel_update() const;
   void destroy();
   void set_position(sf::Vector2f const& position);
   [[nodiscard]] sf::Vector2f get_position() const;
   void set_global_position(sf::Vector2f const& position);
   [[nodiscard]] sf::Vector2f get_global_position() const;
-  void update_children_positions() const;
+  void set_rotation(sf::Angle rotation);
+  [[nodiscard]] sf::Angle get_rotation() const;
+  void set_global_rotation(sf::Angle rotation);
+  [[nodiscard]] sf::Angle get_global_rotation() const;
+  void set_scale(sf::Vector2f const& scale);
+  [[nodiscard]] sf::Vector2f get_scale() const;
+  // local to world, exact even when the propagation has not run yet
+  [[nodiscard]] Matrix2D get_global_transform() const;
+  [[nodiscard]] sf::Vector2f get_render_position() const;
+  // world transform interpolated for the frame being drawn
+  [[nodiscard]] Matrix2D const& get_render_transform() const;
 
   template<typename T, typename... Args>
   T& make_child(Args&&... args);
@@ -74,14 +129,30 @@ T& GameObject::make_child(Args&&... args)
 {
   m_children.push_back(std::make_unique<T>(args...));
   m_children.back()->m_parent = this;
+  // its global position is derived from the parent on the next propagation
+  m_children.back()->mark_transform_dirty();
+  // opted in from its constructor, before it had a parent
+  if (m_children.back()->m_parallel_update
+      || m_children.back()->m_parallel_children) {
+    m_children.back()->mark_parallel_update();
+  }
   m_children.back()->start();
+  if (!active()) {
+    m_children.back()->set_active(false);
+  }
   return static_cast<T&>(*m_children.back().get());
 }
 
 template<typename T, typename... Args>
 T& GameObject::make_component(Args... args)
 {
-  m_components.push_back(std::make_unique<T>(args...));
+  if constexpr (k_component_pools && is_pooled_component<T>) {
+    auto& pool = ComponentPool<T>::instance();
+    m_components.emplace_back(pool.create(args...),
+                              ComponentDeleter{&ComponentPool<T>::release});
+  } else {
+    m_components.emplace_back(std::make_unique<T>(args...).release());
+  }
   m_components.back()->m_parent = this;
   m_components.back()->start(*this);
   return static_cast<T&>(*m_components.back().get());
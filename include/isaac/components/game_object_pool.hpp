@@ -0,0 +1,72 @@
+#ifndef ISAAC_COMPONENTS_GAME_OBJECT_POOL_HPP
+#define ISAAC_COMPONENTS_GAME_OBJECT_POOL_HPP
+
+#include "isaac/components/game_object.hpp"
+#include "isaac/internal/object_registry.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace isaac {
+
+// Recycles children of type T under a parent, for spawners creating and
+// dropping many short lived objects. release() disables an object instead of
+// destroying it, parking it with its components and physics bodies; acquire()
+// enables a parked object, or makes a new child when none is left. Recycled
+// objects reset their state in on_enable. Objects destroyed while parked are
+// skipped.
+template<typename T>
+class GameObjectPool
+{
+  GameObject& m_parent;
+  std::vector<Handle<T>> m_parked;
+
+ public:
+  explicit GameObjectPool(GameObject& parent)
+      : m_parent{parent}
+  {}
+
+  // args are only used when a new child is made
+  template<typename... Args>
+  T& acquire(Args&&... args)
+  {
+    while (!m_parked.empty()) {
+      auto const parked = m_parked.back().get();
+      m_parked.pop_back();
+      if (parked != nullptr) {
+        parked->enable();
+        return *parked;
+      }
+    }
+    return m_parent.make_child<T>(std::forward<Args>(args)...);
+  }
+
+  // releasing an object already parked does nothing
+  void release(T& object)
+  {
+    if (object.enabled()) {
+      object.disable();
+      m_parked.push_back(object);
+    }
+  }
+
+  // parks count more objects up front, so acquire never has to make one
+  template<typename... Args>
+  void reserve(std::size_t count, Args const&... args)
+  {
+    m_parked.reserve(m_parked.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+      release(m_parent.make_child<T>(args...));
+    }
+  }
+
+  [[nodiscard]] std::size_t parked() const
+  {
+    return m_parked.size();
+  }
+};
+
+} // namespace isaac
+
+#endif // ISAAC_COMPONENTS_GAME_OBJECT_POOL_HPP
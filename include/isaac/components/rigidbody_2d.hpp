@@ -2,8 +2,11 @@
 #define ISAAC_COMPONENTS_RIGIDBODY_2D_HPP
 
 #include "isaac/components/collision_body_2d.hpp"
+#include "isaac/components/component_pool.hpp"
 #include "isaac/physics/collision_shape_2d.hpp"
 
+#include <box2d/id.h>
+
 namespace isaac {
 
 class RigidBody2D : public CollisionBody2D
@@ -14,13 +17,21 @@ class RigidBody2D : public CollisionBody2D
     kinematic,
   };
 
+  // made by the first set_restitution
+  b2ShapeId m_shape_id = b2_nullShapeId;
+
  public:
   explicit RigidBody2D(CollisionShape);
 
   void start(GameObject&) override;
-  void update(GameObject&) override;
+  // a recycled body starts at rest
+  void enable(GameObject&) override;
   void set_restitution(float restitution);
 };
+
+template<>
+inline constexpr bool is_pooled_component<RigidBody2D> = true;
+
 } // namespace isaac
 
 #endif
@@ -2,9 +2,16 @@
 #define ISAAC_COMPONENTS_SPRITE_RENDERER_HPP
 
 #include "isaac/components/component.hpp"
+#include "isaac/components/component_pool.hpp"
+#include "isaac/render/shape_batch.hpp"
 
 #include <SFML/Graphics.hpp>
+#include <SFML/System/Angle.hpp>
+
+#include <cstddef>
+#include <span>
 #include <variant>
+#include <vector>
 
 namespace sf {
 class RenderWindow;
@@ -15,14 +22,50 @@ namespace isaac {
 using Shape =
     std::variant<sf::CircleShape, sf::RectangleShape, sf::ConvexShape>;
 
+// Untextured shapes are tessellated once and appended to a batch shared by
+// every ShapeRenderer, drawn by flush() in a single call. Textured shapes are
+// still drawn one by one. The batch is flushed before each of them, and
+// before every overridden GameObject::on_draw, so only consecutive
+// untextured shapes are merged and the tree order is kept.
 class ShapeRenderer : public Component
 {
+  // what the cached geometry was built from, compared on every draw
+  struct ShapeState
+  {
+    std::size_t point_count;
+    sf::FloatRect bounds;
+    // a shape gaining or losing its texture moves in or out of the batch
+    sf::Texture const* texture;
+    sf::Color fill;
+    sf::Color outline;
+    float outline_thickness;
+    sf::Vector2f origin;
+    sf::Vector2f scale;
+    sf::Angle rotation;
+
+    bool operator==(ShapeState const&) const = default;
+  };
+
+  inline static ShapeBatch s_batch{};
+
   std::vector<Shape> m_shapes;
-  sf::Vector2f m_last_position{};
+  std::vector<ShapeState> m_states;
+  std::vector<sf::Vertex> m_geometry;
+  // end of the geometry of each shape, textured ones have none
+  std::vector<std::size_t> m_ends;
+  bool m_textured = false;
+
+  static ShapeState state_of(sf::Shape const& shape);
+  static void append(std::span<sf::Vertex const> geometry,
+                     Matrix2D const& transform);
+  [[nodiscard]] bool geometry_stale() const;
+  void rebuild_geometry();
 
  public:
-  void update(GameObject&) override;
   void draw(GameObject&, sf::RenderWindow&) override;
+  static void flush(sf::RenderTarget& target);
+  // shared batch, for callers submitting or discarding it themselves
+  static ShapeBatch& batch();
 
   template<typename S, typename... Args>
   S& make_shape(Args&&... args)
@@ -31,5 +74,9 @@ class ShapeRenderer : public Component
     return std::get<S>(m_shapes.back());
   }
 };
+
+template<>
+inline constexpr bool is_pooled_component<ShapeRenderer> = true;
+
 } // namespace isaac
 #endif
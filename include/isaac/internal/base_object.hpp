@@ -1,18 +1,31 @@
 #ifndef INTERNAL_BASE_OBJECT_HPP
 #define INTERNAL_BASE_OBJECT_HPP
 
+#include "isaac/internal/object_registry.hpp"
+
 #include <cstddef>
 
 namespace isaac {
 class BaseObject
 {
-  static std::size_t s_instance_count;
-  std::size_t m_id;
+  ObjectHandle m_handle;
 
  public:
   BaseObject();
+  ~BaseObject();
+  // a copy is a new object with its own handle
+  BaseObject(BaseObject const&);
+  // a move takes the handle over, so Handles follow the moved object, and
+  // leaves a new one to the moved from object
+  BaseObject(BaseObject&& other);
+  // assigning keeps the handles of both objects
+  BaseObject& operator=(BaseObject const&);
+  BaseObject& operator=(BaseObject&&);
+
+  // unique for the whole run, ids of destroyed objects are never reused
   [[nodiscard]] std::size_t id() const;
+  [[nodiscard]] ObjectHandle handle() const;
 };
 } // namespace isaac
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,14 @@
+#ifndef INTERNAL_DEMANGLE_HPP
+#define INTERNAL_DEMANGLE_HPP
+
+#include <string>
+
+namespace isaac {
+
+// readable form of a std::type_info name, the name itself when the platform
+// has no demangler or it is not a mangled name
+std::string demangle(char const* name);
+
+} // namespace isaac
+
+#endif
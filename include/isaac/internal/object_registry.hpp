@@ -0,0 +1,101 @@
+#ifndef INTERNAL_OBJECT_REGISTRY_HPP
+#define INTERNAL_OBJECT_REGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace isaac {
+
+class BaseObject;
+
+// Index of a registry slot plus the generation it was issued with. A handle
+// outlives its object safely: once the slot is released the generation no
+// longer matches and lookups return nullptr.
+struct ObjectHandle
+{
+  static constexpr auto k_invalid = std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t index      = k_invalid;
+  std::uint32_t generation = 0;
+
+  [[nodiscard]] std::uint64_t value() const;
+  [[nodiscard]] static ObjectHandle from_value(std::uint64_t value);
+  // packed into a pointer sized integer, for the user data of other
+  // libraries. On 32-bit targets only 24 bits of index and the low 8 bits of
+  // the generation fit, see ObjectRegistry::from_pointer_value
+  [[nodiscard]] std::uintptr_t pointer_value() const;
+  bool operator==(ObjectHandle const&) const = default;
+};
+
+// Slot map of every live BaseObject. Insertion, removal and lookup are O(1)
+// and slots are recycled through a free list. Not thread safe: objects are
+// created and destroyed on the main thread.
+class ObjectRegistry
+{
+  struct Slot
+  {
+    BaseObject* object       = nullptr;
+    // starts at 1 so a valid handle never packs to 0
+    std::uint32_t generation = 1;
+    std::uint32_t next_free  = ObjectHandle::k_invalid;
+  };
+
+  std::vector<Slot> m_slots;
+  std::uint32_t m_free_head = ObjectHandle::k_invalid;
+  std::size_t m_size        = 0;
+
+ public:
+  static ObjectRegistry& instance();
+
+  ObjectHandle insert(BaseObject& object);
+  void erase(ObjectHandle handle);
+  // points a live handle to the object that took over its identity
+  void rebind(ObjectHandle handle, BaseObject& object);
+  [[nodiscard]] BaseObject* get(ObjectHandle handle) const;
+  // nullptr for a stale value, unless on a 32-bit target its slot was
+  // recycled a multiple of 256 times
+  [[nodiscard]] BaseObject* from_pointer_value(std::uintptr_t value) const;
+  [[nodiscard]] bool alive(ObjectHandle handle) const;
+  [[nodiscard]] std::size_t size() const;
+};
+
+// Typed weak reference to a BaseObject derived class
+template<typename T>
+class Handle
+{
+  ObjectHandle m_handle{};
+
+ public:
+  Handle() = default;
+  Handle(T& object)
+      : m_handle{object.handle()}
+  {}
+
+  [[nodiscard]] T* get() const
+  {
+    return static_cast<T*>(ObjectRegistry::instance().get(m_handle));
+  }
+  [[nodiscard]] bool alive() const
+  {
+    return ObjectRegistry::instance().alive(m_handle);
+  }
+  [[nodiscard]] ObjectHandle raw() const
+  {
+    return m_handle;
+  }
+  T* operator->() const
+  {
+    return get();
+  }
+  explicit operator bool() const
+  {
+    return alive();
+  }
+  bool operator==(Handle const&) const = default;
+};
+
+} // namespace isaac
+
+#endif
@@ -4,12 +4,16 @@
 #include "isaac/physics/physics_2d.hpp"
 #include "isaac/render/window_server.hpp"
 #include "isaac/scene/scene_manager.hpp"
+#include "isaac/system/defaults.hpp"
+#include "isaac/system/event_bus.hpp"
 #include "isaac/system/input.hpp"
 #include "isaac/system/logger.hpp"
+#include "isaac/system/thread.hpp"
 #include "isaac/system/world.hpp"
 
 #include <SFML/System/Vector2.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -26,17 +30,30 @@ class Isaac
   std::unique_ptr<PhysicsServer2D> m_physics_server;
   std::unique_ptr<SceneManager> m_scene_manager;
   std::unique_ptr<Input> m_input;
+  std::unique_ptr<EventBus> m_event_bus;
+  std::unique_ptr<JobSystem> m_jobs;
   World m_world;
 
   std::unique_ptr<Scene> m_main_scene;
 
  public:
   Isaac(std::string name, sf::Vector2u window_size,
-        Logger::Level = Logger::Level::INFO);
+        Logger::Level = Logger::Level::INFO,
+        std::size_t physics_workers = Defaults::k_physics_workers,
+        std::size_t job_workers     = Defaults::k_job_workers);
+  explicit Isaac(headless_t, Logger::Level = Logger::Level::INFO,
+                 std::size_t physics_workers = Defaults::k_physics_workers,
+                 std::size_t job_workers     = Defaults::k_job_workers);
   ~Isaac();
 
   void set_scene(std::unique_ptr<Scene> scene);
-  int run();
+  void set_fixed_update_rate(float update_rate);
+  void set_physics_settings(PhysicsSettings const& settings);
+  // overlays the Box2D shapes in view, off by default. Its options are on
+  // PhysicsServer2D::debug_drawer
+  void set_physics_debug_draw(bool enabled);
+  int run(std::size_t ticks = 0);
+  void stop();
 
  private:
   bool start();
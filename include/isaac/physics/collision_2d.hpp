@@ -1,13 +1,33 @@
 #ifndef PHYSICS_COLLISION_2D_HPP
 #define PHYSICS_COLLISION_2D_HPP
 
+#include <SFML/System/Vector2.hpp>
+
 namespace isaac {
-class Collider2D;
+class CollisionBody2D;
 class GameObject;
+
+// Delivered to GameObject::on_collision_2d for both objects of a contact,
+// `collider` is always the body owned by the notified GameObject
 struct Collision2D
 {
-  Collider2D* collider;
-  Collider2D* other;
+  enum class Type
+  {
+    begin,
+    end,
+    hit,
+    sensor_begin,
+    sensor_end,
+  };
+
+  Type type;
+  CollisionBody2D* collider = nullptr;
+  CollisionBody2D* other    = nullptr;
+  // contact point and normal from collider to other, set for begin and hit
+  sf::Vector2f point{};
+  sf::Vector2f normal{};
+  // relative speed along the normal, set for hit events only
+  float approach_speed = 0;
 };
 } // namespace isaac
 #endif
@@ -1,7 +1,10 @@
 #ifndef ISAAC_PHYSICS_COLLISION_SHAPE_2D_HPP
 #define ISAAC_PHYSICS_COLLISION_SHAPE_2D_HPP
 
+#include "isaac/physics/shape_cache.hpp"
+
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Angle.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <box2d/box2d.h>
 
@@ -14,35 +17,50 @@ class Circle2DShape;
 
 using CollisionShape = std::variant<Box2DShape, Circle2DShape>;
 
+// A reference to an interned ShapePrototype, shapes with the same geometry
+// and flags share their polygon or circle and their b2ShapeDef
 class CollisionShapeBase
 {
-  b2ShapeDef m_shape_def{b2DefaultShapeDef()};
+  ShapePrototype const* m_prototype;
+
+  void set_key(ShapeKey const& key);
+
+ protected:
+  explicit CollisionShapeBase(ShapeKey const& key);
+  [[nodiscard]] ShapePrototype const& prototype() const;
 
  public:
   b2ShapeDef const& shape_def() const;
   virtual b2ShapeId make_shape(b2BodyId body) = 0;
+  // the shape centred on center, for PhysicsServer2D shape casts
+  [[nodiscard]] virtual b2ShapeProxy make_proxy(sf::Vector2f center,
+                                                sf::Angle rotation = {}) const
+      = 0;
+
+  // must be set before the shape is attached to a body
+  void set_sensor(bool sensor);
+  void enable_sensor_events(bool enable);
+  void enable_hit_events(bool enable);
 };
 
 class Box2DShape : public CollisionShapeBase
 {
-  b2Polygon m_polygon;
-  b2Vec2 m_size;
-
  public:
   explicit Box2DShape(sf::Vector2f size);
-  b2Vec2 const& size() const;
+  b2Vec2 size() const;
   b2ShapeId make_shape(b2BodyId body) override;
+  [[nodiscard]] b2ShapeProxy make_proxy(sf::Vector2f center,
+                                        sf::Angle rotation = {}) const override;
 };
 
 class Circle2DShape : public CollisionShapeBase
 {
-  b2Circle m_circle;
-  float m_radius;
-
  public:
   explicit Circle2DShape(float radius);
   float get_radius() const;
   b2ShapeId make_shape(b2BodyId body) override;
+  [[nodiscard]] b2ShapeProxy make_proxy(sf::Vector2f center,
+                                        sf::Angle rotation = {}) const override;
 };
 
 } // namespace isaac
@@ -0,0 +1,59 @@
+#ifndef ISAAC_PHYSICS_DEBUG_DRAW_2D_HPP
+#define ISAAC_PHYSICS_DEBUG_DRAW_2D_HPP
+
+#include <box2d/box2d.h>
+#include <box2d/types.h>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace isaac {
+
+// Box2D debug geometry accumulated into a triangle list for the fills and a
+// line list for the outlines, submitted with two draw calls. Only the shapes
+// overlapping the view are visited. The buffers keep their capacity between
+// frames.
+class DebugDraw2D
+{
+  b2DebugDraw m_draw;
+  std::vector<sf::Vertex> m_triangles;
+  std::vector<sf::Vertex> m_lines;
+
+  static void draw_polygon(b2Vec2 const* vertices, int vertex_count,
+                           b2HexColor color, void* context);
+  static void draw_solid_polygon(b2Transform transform,
+                                 b2Vec2 const* vertices, int vertex_count,
+                                 float radius, b2HexColor color,
+                                 void* context);
+  static void draw_circle(b2Vec2 center, float radius, b2HexColor color,
+                          void* context);
+  static void draw_solid_circle(b2Transform transform, float radius,
+                                b2HexColor color, void* context);
+  static void draw_segment(b2Vec2 a, b2Vec2 b, b2HexColor color,
+                           void* context);
+  static void draw_point(b2Vec2 p, float size, b2HexColor color,
+                         void* context);
+
+ public:
+  DebugDraw2D();
+
+  // shapes are drawn by default, bounds are not
+  void set_draw_shapes(bool draw);
+  void set_draw_bounds(bool draw);
+
+  // appends the shapes of world overlapping view
+  void collect(b2WorldId world, sf::View const& view);
+  // draws and clears what was collected
+  void draw(sf::RenderTarget& target);
+  void clear();
+  // clears and frees the buffers
+  void release();
+  [[nodiscard]] std::size_t vertex_count() const;
+};
+
+} // namespace isaac
+#endif // ISAAC_PHYSICS_DEBUG_DRAW_2D_HPP
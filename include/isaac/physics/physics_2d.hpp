@@ -2,43 +2,132 @@
 #define ISAAC_PHYSICS_PHYSICS_2D
 
 #include "isaac/components/collision_body_2d.hpp"
+#include "isaac/physics/collision_2d.hpp"
+#include "isaac/physics/debug_draw_2d.hpp"
+#include "isaac/physics/physics_settings.hpp"
+#include "isaac/physics/query_2d.hpp"
 #include "isaac/system/logger.hpp"
+#include "isaac/system/thread.hpp"
 
 #include <box2d/box2d.h>
 #include <box2d/types.h>
 
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
 namespace isaac {
 
 class CollisionObject2D;
 class RigidBody2D;
 
-class DebugDrawer
-{
-  b2DebugDraw drawer;
-  DebugDrawer();
-};
-
 template<typename T>
 concept is_collision_body = std::is_base_of_v<CollisionBody2D, T>;
 
 class PhysicsServer2D
 {
+ public:
+  static constexpr float k_gravity = 9.81f * 100;
+  static constexpr int k_max_tasks = 128;
+  // steps within half the budget before the adaptive mode adds a sub-step
+  static constexpr int k_adaptive_steps = 60;
+
+ private:
   Logger& m_logger;
+  WorkerPool m_worker_pool;
+  // Box2D tasks issued during the current step, recycled after each step
+  std::array<ParallelJob, k_max_tasks> m_tasks;
+  int m_task_count = 0;
   b2WorldId m_world_id;
-  b2DebugDraw m_debug_drawer;
+  DebugDraw2D m_debug_draw;
+  bool m_debug_draw_enabled = false;
+  PhysicsSettings m_settings;
+  // sub-steps of the next step, below the configured ones when adapting
+  int m_sub_steps  = 0;
+  int m_fast_steps = 0;
+  // bodies following sleep_threshold, pruned of destroyed bodies once the
+  // list doubles
+  std::vector<b2BodyId> m_default_sleep_bodies;
+  std::size_t m_prune_at = 64;
 
- public:
-  static constexpr float k_gravity = 9.81f * 100;
+  static void* enqueue_task(b2TaskCallback* task, int item_count,
+                            int min_range, void* task_context,
+                            void* user_context);
+  static void finish_task(void* user_task, void* user_context);
+  void adapt_sub_steps(float step_time);
+  b2BodyId create_body(b2BodyDef def);
+  void prune_default_sleep_bodies();
+  void sync_bodies();
+  void dispatch_collisions();
+  static void dispatch(b2ShapeId shape_a, b2ShapeId shape_b,
+                       Collision2D collision);
 
-  PhysicsServer2D();
+ public:
+  explicit PhysicsServer2D(std::size_t worker_count          = 1,
+                           PhysicsSettings const& settings = {});
   ~PhysicsServer2D();
 
+  // a body keeping the default sleep threshold follows the settings
   template<is_collision_body T>
   b2BodyId create_body(T const& object)
   {
-    return b2CreateBody(m_world_id, &object.body_def());
+    return create_body(object.body_def());
   }
   void update(float delta);
+  // takes effect from the next step, sub-step counts are clamped to at
+  // least one
+  void set_settings(PhysicsSettings const& settings);
+  [[nodiscard]] PhysicsSettings const& settings() const;
+  // sub-steps the next step runs, lower than the configured ones while the
+  // adaptive mode is cutting back
+  [[nodiscard]] int sub_steps() const;
+
+  // Debug overlay of the shapes in view, batched into two draw calls. Off by
+  // default, debug_draw does nothing until enabled. World calls it once per
+  // rendered frame
+  void set_debug_draw(bool enabled);
+  [[nodiscard]] bool debug_draw_enabled() const;
+  // options of the built-in overlay, such as set_draw_bounds
+  DebugDraw2D& debug_drawer();
+  void debug_draw(sf::RenderTarget& target);
+  // appends the shapes overlapping view to batch, whether enabled or not
+  void debug_draw(DebugDraw2D& batch, sf::View const& view) const;
+
+  // Queries of the broadphase. They only read the world, so they can run
+  // from any thread as long as the world is not stepping and no body is
+  // created or destroyed meanwhile.
+
+  // closest shape along the ray
+  [[nodiscard]] CastHit2D raycast(
+      Ray2D const& ray, b2QueryFilter filter = b2DefaultQueryFilter()) const;
+  // closest shape hit by the swept shape
+  [[nodiscard]] CastHit2D shape_cast(
+      ShapeCast2D const& cast,
+      b2QueryFilter filter = b2DefaultQueryFilter()) const;
+  // appends the bodies whose bounds overlap area, returns how many
+  std::size_t overlap(sf::FloatRect const& area,
+                      std::vector<CollisionBody2D*>& bodies,
+                      b2QueryFilter filter = b2DefaultQueryFilter()) const;
+
+  // Batched variants writing one result per query, hits must be at least as
+  // long as the queries. Given a JobSystem the queries are spread over its
+  // workers and the call returns once all of them are done.
+  void raycast(std::span<Ray2D const> rays, std::span<CastHit2D> hits,
+               b2QueryFilter filter = b2DefaultQueryFilter(),
+               JobSystem* jobs      = nullptr) const;
+  void shape_cast(std::span<ShapeCast2D const> casts,
+                  std::span<CastHit2D> hits,
+                  b2QueryFilter filter = b2DefaultQueryFilter(),
+                  JobSystem* jobs      = nullptr) const;
+  // results are resized to the number of areas
+  void overlap(std::span<sf::FloatRect const> areas, OverlapResults2D& results,
+               b2QueryFilter filter = b2DefaultQueryFilter(),
+               JobSystem* jobs      = nullptr) const;
 };
 } // namespace isaac
 
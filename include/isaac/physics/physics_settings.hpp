@@ -0,0 +1,49 @@
+#ifndef ISAAC_PHYSICS_PHYSICS_SETTINGS_HPP
+#define ISAAC_PHYSICS_PHYSICS_SETTINGS_HPP
+
+#include <box2d/types.h>
+
+namespace isaac {
+
+namespace detail {
+b2WorldDef const& default_world_def();
+b2BodyDef const& default_body_def();
+} // namespace detail
+
+// Accuracy and throughput trade-offs of the Box2D world, given to
+// PhysicsServer2D at construction and changeable with set_settings. Values
+// default to Box2D's own, in world units.
+struct PhysicsSettings
+{
+  // solver sub-steps per world step, more is stiffer and slower
+  int sub_steps = 4;
+  // drops a sub-step, down to min_sub_steps, when a world step takes longer
+  // than step_budget seconds, and adds one back once steps have fitted in
+  // half the budget for a while
+  bool adaptive_sub_steps = false;
+  int min_sub_steps       = 1;
+  float step_budget       = 0.004f;
+
+  // stiffness of the contacts and how fast overlaps are pushed apart
+  float contact_hertz         = detail::default_world_def().contactHertz;
+  float contact_damping_ratio = detail::default_world_def().contactDampingRatio;
+  float contact_push_speed    = detail::default_world_def().maxContactPushSpeed;
+  float maximum_linear_speed  = detail::default_world_def().maximumLinearSpeed;
+
+  bool enable_sleep = detail::default_world_def().enableSleep;
+  // speed under which a body may fall asleep. Applies to every body whose
+  // definition kept the Box2D default, including existing ones
+  float sleep_threshold = detail::default_body_def().sleepThreshold;
+  // continuous collision of dynamic bodies against static ones
+  bool enable_continuous = detail::default_world_def().enableContinuous;
+
+  // approach speeds under which contacts do not bounce, and do not report
+  // hit events
+  float restitution_threshold =
+      detail::default_world_def().restitutionThreshold;
+  float hit_event_threshold = detail::default_world_def().hitEventThreshold;
+};
+
+} // namespace isaac
+
+#endif // ISAAC_PHYSICS_PHYSICS_SETTINGS_HPP
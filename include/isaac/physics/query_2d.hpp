@@ -0,0 +1,65 @@
+#ifndef ISAAC_PHYSICS_QUERY_2D_HPP
+#define ISAAC_PHYSICS_QUERY_2D_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <box2d/collision.h>
+#include <box2d/id.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace isaac {
+class CollisionBody2D;
+
+// Segment from origin to origin + translation
+struct Ray2D
+{
+  sf::Vector2f origin{};
+  sf::Vector2f translation{};
+};
+
+// Shape swept along translation, see CollisionShapeBase::make_proxy
+struct ShapeCast2D
+{
+  b2ShapeProxy shape{};
+  sf::Vector2f translation{};
+};
+
+// Closest shape found by a ray or a shape cast
+struct CastHit2D
+{
+  bool hit = false;
+  // null when the shape does not belong to a CollisionBody2D
+  CollisionBody2D* body = nullptr;
+  b2ShapeId shape       = b2_nullShapeId;
+  sf::Vector2f point{};
+  sf::Vector2f normal{};
+  // fraction of the translation travelled before the hit
+  float fraction = 1.f;
+};
+
+// Bodies found by a batch of overlap queries, stored in one flat buffer with
+// room for max_per_query bodies per query. A query finding more keeps the
+// first ones and reports itself as truncated.
+class OverlapResults2D
+{
+  std::size_t m_max_per_query;
+  std::vector<CollisionBody2D*> m_bodies;
+  std::vector<std::size_t> m_found;
+
+  friend class PhysicsServer2D;
+
+ public:
+  explicit OverlapResults2D(std::size_t max_per_query = 16);
+
+  // makes room for query_count queries, keeping the buffer allocated
+  void resize(std::size_t query_count);
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::span<CollisionBody2D* const> operator[](
+      std::size_t query) const;
+  [[nodiscard]] bool truncated(std::size_t query) const;
+};
+
+} // namespace isaac
+#endif
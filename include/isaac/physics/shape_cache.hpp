@@ -0,0 +1,71 @@
+#ifndef ISAAC_PHYSICS_SHAPE_CACHE_HPP
+#define ISAAC_PHYSICS_SHAPE_CACHE_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <box2d/collision.h>
+#include <box2d/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace isaac {
+
+// Everything a collision shape is built from: its geometry and the flags of
+// its b2ShapeDef, the other fields keep their Box2D defaults
+struct ShapeKey
+{
+  enum class Type : std::uint8_t
+  {
+    box,
+    circle,
+  };
+
+  Type type{};
+  // the size of a box, the radius of a circle in x
+  sf::Vector2f extent{};
+  bool sensor        = false;
+  bool sensor_events = false;
+  bool hit_events    = false;
+
+  // flags initialised from b2DefaultShapeDef
+  static ShapeKey of(Type type, sf::Vector2f extent);
+  bool operator==(ShapeKey const&) const = default;
+};
+
+struct ShapeKeyHash
+{
+  std::size_t operator()(ShapeKey const& key) const;
+};
+
+// Geometry and shape definition shared by every shape with the same key
+struct ShapePrototype
+{
+  ShapeKey key;
+  b2ShapeDef def;
+  b2Polygon polygon{};
+  b2Circle circle{};
+};
+
+// Interns ShapePrototypes, each one is built the first time its key is seen
+// and kept for the whole run, so shapes can hold on to them. Prototypes are
+// never freed: the cache holds one per distinct key, so shapes of ever
+// changing sizes make it grow without bound. Thread safe, shapes are also
+// built on job workers to make query proxies.
+class ShapeCache
+{
+  mutable std::mutex m_mutex;
+  // nodes of an unordered_map do not move when it rehashes
+  std::unordered_map<ShapeKey, ShapePrototype, ShapeKeyHash> m_prototypes;
+
+ public:
+  static ShapeCache& instance();
+
+  ShapePrototype const& get(ShapeKey const& key);
+  [[nodiscard]] std::size_t size() const;
+};
+
+} // namespace isaac
+
+#endif // ISAAC_PHYSICS_SHAPE_CACHE_HPP
@@ -1,14 +1,98 @@
 #ifndef ISAAC_PHYSICS_TRANSFORM_HPP
 #define ISAAC_PHYSICS_TRANSFORM_HPP
 
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Angle.hpp>
 #include <SFML/System/Vector2.hpp>
 
+#include <cstddef>
+#include <vector>
+
 namespace isaac {
 
-struct Transform {
-public:
+// 2D affine matrix, mapping (x, y) to (a x + c y + tx, b x + d y + ty)
+struct Matrix2D
+{
+  float a  = 1.f;
+  float b  = 0.f;
+  float c  = 0.f;
+  float d  = 1.f;
+  float tx = 0.f;
+  float ty = 0.f;
+
+  // scale, then rotation, then translation, as sf::Transformable
+  static Matrix2D from(sf::Vector2f position, sf::Angle rotation,
+                       sf::Vector2f scale);
+
+  // applies local first, then this
+  Matrix2D operator*(Matrix2D const& local) const
+  {
+    return {a * local.a + c * local.b,
+            b * local.a + d * local.b,
+            a * local.c + c * local.d,
+            b * local.c + d * local.d,
+            a * local.tx + c * local.ty + tx,
+            b * local.tx + d * local.ty + ty};
+  }
+
+  [[nodiscard]] sf::Vector2f transform_point(sf::Vector2f point) const
+  {
+    return {a * point.x + c * point.y + tx, b * point.x + d * point.y + ty};
+  }
+
+  [[nodiscard]] sf::Vector2f transform_vector(sf::Vector2f vector) const
+  {
+    return {a * vector.x + c * vector.y, b * vector.x + d * vector.y};
+  }
+
+  [[nodiscard]] sf::Vector2f translation() const
+  {
+    return {tx, ty};
+  }
+
+  [[nodiscard]] Matrix2D inverse() const;
+  // rotation and scale of the matrix, assuming it has no shear
+  [[nodiscard]] sf::Angle rotation() const;
+  [[nodiscard]] sf::Vector2f scale() const;
+  [[nodiscard]] sf::Transform sf_transform() const;
+
+  bool operator==(Matrix2D const&) const = default;
+};
+
+// Matrices stored one component per array, the layout compose() works on
+struct MatrixArray
+{
+  std::vector<float> a;
+  std::vector<float> b;
+  std::vector<float> c;
+  std::vector<float> d;
+  std::vector<float> tx;
+  std::vector<float> ty;
+
+  void resize(std::size_t size);
+  [[nodiscard]] std::size_t size() const;
+  void set(std::size_t i, Matrix2D const& matrix);
+  [[nodiscard]] Matrix2D get(std::size_t i) const;
+};
+
+// out[i] = parents[i] * locals[i] for every i, four at a time with SSE.
+// out is resized to the size of parents, which locals must match
+void compose(MatrixArray const& parents, MatrixArray const& locals,
+             MatrixArray& out);
+
+struct Transform
+{
   sf::Vector2f position{};
-  sf::Vector2f global_position{};
+  sf::Angle rotation{};
+  sf::Vector2f scale{1.f, 1.f};
+  // built from position, rotation and scale whenever one of them changes
+  Matrix2D local{};
+  // local to world, refreshed by the transform propagation
+  Matrix2D world{};
+  // world at the end of the previous fixed step, used to interpolate the
+  // rendered transform between two simulation states
+  Matrix2D previous_world{};
+  Matrix2D render{};
 };
 
 } // namespace isaac
@@ -0,0 +1,38 @@
+#ifndef ISAAC_RENDER_SHAPE_BATCH_HPP
+#define ISAAC_RENDER_SHAPE_BATCH_HPP
+
+#include "isaac/physics/transform.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace isaac {
+
+// Collects untextured geometry as a single triangle list, submitted with one
+// draw call per frame. The buffer keeps its capacity between frames.
+class ShapeBatch
+{
+  std::vector<sf::Vertex> m_vertices;
+
+ public:
+  void append(std::span<sf::Vertex const> triangles, sf::Vector2f offset);
+  void append(std::span<sf::Vertex const> triangles,
+              Matrix2D const& transform);
+  void draw(sf::RenderTarget& target);
+  void clear();
+  [[nodiscard]] std::size_t vertex_count() const;
+
+  // Appends the fill and outline triangles of a convex shape, relative to the
+  // shape position. Origin, rotation and scale are applied.
+  static void tessellate(sf::Shape const& shape,
+                         std::vector<sf::Vertex>& triangles);
+};
+
+} // namespace isaac
+#endif // ISAAC_RENDER_SHAPE_BATCH_HPP
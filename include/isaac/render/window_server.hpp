@@ -6,14 +6,25 @@
 #include <string>
 
 namespace isaac {
+
+// tag selecting the windowless backend, used for CI and batch simulations
+struct headless_t
+{
+  explicit headless_t() = default;
+};
+inline constexpr headless_t headless{};
+
 class WindowServer
 {
   sf::RenderWindow m_window;
+  bool m_headless = false;
 
  public:
   WindowServer(sf::Vector2u const& window_size, std::string const& title);
+  explicit WindowServer(headless_t);
   ~WindowServer();
   sf::RenderWindow& get_window();
+  [[nodiscard]] bool headless() const;
 };
 } // namespace isaac
 #endif
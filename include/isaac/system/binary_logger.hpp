@@ -0,0 +1,121 @@
+#ifndef ISAAC_SYSTEM_BINARY_LOGGER_HPP
+#define ISAAC_SYSTEM_BINARY_LOGGER_HPP
+
+#include "isaac/system/logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace isaac {
+
+// Sink appending compact binary records to a memory mapped file. Messages
+// logged through the ISAAC_LOG macros are stored as a template id plus their
+// raw arguments, so nothing is formatted at runtime. BinaryLogReader and the
+// isaac-log-decode tool turn the file back into text or JSON.
+//
+// Layout, in the byte order of the writing machine:
+//   header    "ISAACLOG", u32 version, u32 reserved
+//   records   u32 size, u8 type, payload, padded to a multiple of 8 bytes
+//   template  u8[3] padding, u32 id, the template text
+//   message   u8 level, u8 argument count, u8 padding, i64 nanoseconds since
+//             the epoch, u32 template id, then per argument a u8 type and
+//             either an 8 byte value or a u32 size followed by the bytes
+// A record size of 0 marks the end of the log. Template ids restart with
+// every logger, a template record always precedes the messages using it.
+class BinaryLogger : public Logger
+{
+ public:
+  static constexpr std::size_t k_default_capacity = 64 << 20;
+  static constexpr std::size_t k_header_size      = 16;
+  static constexpr std::uint32_t k_version        = 1;
+  // template of messages logged with log() rather than the macros
+  static constexpr std::uint32_t k_text_template = 0;
+
+  static constexpr char k_magic[8] = {'I', 'S', 'A', 'A', 'C', 'L', 'O', 'G'};
+
+  enum class RecordType : std::uint8_t
+  {
+    template_text,
+    message,
+  };
+
+  // order of the LogArg alternatives
+  enum class ArgType : std::uint8_t
+  {
+    int64,
+    uint64,
+    float64,
+    boolean,
+    string,
+  };
+
+ private:
+  int m_fd          = -1;
+  std::byte* m_data = nullptr;
+  std::size_t m_capacity;
+  mutable std::atomic<std::size_t> m_offset;
+  mutable std::atomic<std::size_t> m_dropped{0};
+  // guards template registration, lookups go through a per thread cache
+  mutable std::mutex m_mutex;
+  mutable std::unordered_map<std::string_view, std::uint32_t> m_templates;
+  std::uint64_t m_instance;
+
+  std::byte* reserve(std::size_t size) const;
+  std::uint32_t template_id(std::string_view fmt) const;
+  void write_message(Level log_level, std::uint32_t id,
+                     std::span<LogArg const> args) const;
+
+ public:
+  // appends to path when it already holds a log, capacity bytes are mapped
+  // for this logger and messages past them are dropped
+  explicit BinaryLogger(std::filesystem::path const& path,
+                        Level log_level      = INFO,
+                        std::size_t capacity = k_default_capacity);
+  ~BinaryLogger() override;
+  BinaryLogger(BinaryLogger const&)            = delete;
+  BinaryLogger& operator=(BinaryLogger const&) = delete;
+
+  void log(std::string_view const& msg, Level log_level) const override;
+  void log_structured(Level log_level, std::string_view fmt,
+                      std::span<LogArg const> args) const override;
+  // messages that did not fit in the mapped capacity
+  [[nodiscard]] std::size_t dropped() const;
+};
+
+struct BinaryLogRecord
+{
+  std::chrono::system_clock::time_point time;
+  LoggerService::Level level;
+  std::string_view fmt;
+  // strings are views into the reader's buffer
+  std::vector<LogArg> args;
+
+  [[nodiscard]] std::string message() const;
+};
+
+// Reads back the records of a BinaryLogger file, in the order written
+class BinaryLogReader
+{
+  std::vector<char> m_data;
+  std::size_t m_offset = BinaryLogger::k_header_size;
+  std::unordered_map<std::uint32_t, std::string_view> m_templates;
+
+ public:
+  // throws std::runtime_error if path is not a binary log
+  explicit BinaryLogReader(std::filesystem::path const& path);
+  std::optional<BinaryLogRecord> next();
+};
+
+} // namespace isaac
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef DEFAULTS_HPP
 #define DEFAULTS_HPP
 
+#include <cstddef>
+
 namespace isaac {
 class Defaults
 {
@@ -9,6 +11,16 @@ class Defaults
   static constexpr int k_screen_width  = 1280;
   static constexpr int k_screen_height = 900;
   static constexpr float k_max_fps     = 60;
+  // simulation steps per second, 0 falls back to a variable time step
+  static constexpr float k_fixed_update_rate = 60;
+  // longest frame fed to the accumulator, avoids the spiral of death
+  static constexpr float k_max_frame_time = 0.25f;
+  // threads stepping the physics world, the main thread included. 0 uses
+  // every hardware thread
+  static constexpr std::size_t k_physics_workers = 1;
+  // threads running the job system, the main thread included. 0 uses every
+  // hardware thread
+  static constexpr std::size_t k_job_workers = 0;
 };
 } // namespace isaac
 #endif
@@ -0,0 +1,312 @@
+#ifndef ISAAC_SYSTEM_EVENT_BUS_HPP
+#define ISAAC_SYSTEM_EVENT_BUS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace isaac {
+
+// Non owning callable bound to a member or free function, invoked through a
+// plain function pointer rather than a virtual call
+template<typename Event>
+class EventDelegate
+{
+  using Function = void (*)(void*, Event const&);
+
+  void* m_instance    = nullptr;
+  Function m_function = nullptr;
+
+  EventDelegate(void* instance, Function function)
+      : m_instance{instance}
+      , m_function{function}
+  {}
+
+ public:
+  EventDelegate() = default;
+
+  template<auto Method, typename T>
+  static EventDelegate bind(T& instance)
+  {
+    return {&instance, [](void* self, Event const& event) {
+              (static_cast<T*>(self)->*Method)(event);
+            }};
+  }
+
+  template<void (*Function)(Event const&)>
+  static EventDelegate bind()
+  {
+    return {nullptr, [](void*, Event const& event) { Function(event); }};
+  }
+
+  void operator()(Event const& event) const
+  {
+    m_function(m_instance, event);
+  }
+
+  [[nodiscard]] void const* instance() const
+  {
+    return m_instance;
+  }
+
+  explicit operator bool() const
+  {
+    return m_function != nullptr;
+  }
+
+  bool operator==(EventDelegate const&) const = default;
+};
+
+class EventQueueBase
+{
+ public:
+  virtual ~EventQueueBase() = default;
+  // fixes the events delivered by the next dispatch
+  virtual void mark()                                = 0;
+  virtual std::size_t dispatch()                     = 0;
+  virtual void unsubscribe_all(void const* instance) = 0;
+  [[nodiscard]] virtual std::size_t pending() const  = 0;
+};
+
+// Ring buffer of events of one type and the delegates receiving them. The
+// buffer only grows when a frame publishes more events than ever before.
+template<typename Event>
+class EventQueue : public EventQueueBase
+{
+  static_assert(std::is_default_constructible_v<Event>
+                    && std::is_copy_assignable_v<Event>,
+                "events are stored by value in a preallocated ring buffer");
+
+  std::vector<Event> m_ring;
+  std::size_t m_head = 0;
+  std::size_t m_tail = 0;
+  std::size_t m_end  = 0;
+  std::vector<EventDelegate<Event>> m_subscribers;
+  // unsubscribing while dispatching only clears the delegate, the slot is
+  // removed once the outermost dispatch is over
+  int m_dispatching = 0;
+  bool m_removed    = false;
+
+  [[nodiscard]] std::size_t mask() const
+  {
+    return m_ring.size() - 1;
+  }
+
+  void grow()
+  {
+    std::vector<Event> ring(std::max<std::size_t>(m_ring.size() * 2, 64));
+    for (auto i = m_head; i != m_tail; ++i) {
+      ring[i & (ring.size() - 1)] = std::move(m_ring[i & mask()]);
+    }
+    m_ring = std::move(ring);
+  }
+
+  void deliver(Event const& event)
+  {
+    for (std::size_t i = 0; i < m_subscribers.size(); ++i) {
+      // copied, a delegate subscribing may reallocate the vector
+      if (auto const delegate = m_subscribers[i]) {
+        delegate(event);
+      }
+    }
+  }
+
+  void compact()
+  {
+    if (m_removed && m_dispatching == 0) {
+      std::erase(m_subscribers, EventDelegate<Event>{});
+      m_removed = false;
+    }
+  }
+
+ public:
+  explicit EventQueue(std::size_t capacity = 64)
+  {
+    reserve(capacity);
+  }
+
+  // rounded up to a power of two
+  void reserve(std::size_t capacity)
+  {
+    while (m_ring.size() < capacity) {
+      grow();
+    }
+  }
+
+  void subscribe(EventDelegate<Event> delegate)
+  {
+    if (std::ranges::find(m_subscribers, delegate) == m_subscribers.end()) {
+      m_subscribers.push_back(delegate);
+    }
+  }
+
+  void unsubscribe(EventDelegate<Event> delegate)
+  {
+    auto const it = std::ranges::find(m_subscribers, delegate);
+    if (it != m_subscribers.end()) {
+      *it       = {};
+      m_removed = true;
+      compact();
+    }
+  }
+
+  void unsubscribe_all(void const* instance) override
+  {
+    for (auto& delegate : m_subscribers) {
+      if (delegate && delegate.instance() == instance) {
+        delegate  = {};
+        m_removed = true;
+      }
+    }
+    compact();
+  }
+
+  void publish(Event const& event)
+  {
+    if (m_tail - m_head == m_ring.size()) {
+      grow();
+    }
+    m_ring[m_tail++ & mask()] = event;
+  }
+
+  // delivers immediately, bypassing the queue
+  void send(Event const& event)
+  {
+    ++m_dispatching;
+    deliver(event);
+    --m_dispatching;
+    compact();
+  }
+
+  void mark() override
+  {
+    m_end = m_tail;
+  }
+
+  std::size_t dispatch() override
+  {
+    auto const count = m_end - m_head;
+    ++m_dispatching;
+    while (m_head != m_end) {
+      // copied out, a delegate publishing may grow the ring
+      Event const event = m_ring[m_head & mask()];
+      ++m_head;
+      deliver(event);
+    }
+    --m_dispatching;
+    compact();
+    return count;
+  }
+
+  [[nodiscard]] std::size_t pending() const override
+  {
+    return m_tail - m_head;
+  }
+};
+
+namespace detail {
+
+std::size_t next_event_type();
+
+template<typename Event>
+std::size_t event_type()
+{
+  static std::size_t const type = next_event_type();
+  return type;
+}
+
+template<typename Method>
+struct method_event;
+
+template<typename T, typename Event>
+struct method_event<void (T::*)(Event const&)>
+{
+  using type = Event;
+};
+
+template<typename T, typename Event>
+struct method_event<void (T::*)(Event const&) const>
+{
+  using type = Event;
+};
+
+} // namespace detail
+
+// Deferred, typed event delivery. publish() queues an event in the ring
+// buffer of its type, drain() hands every queued event to the delegates
+// subscribed to that type. World drains the bus once per frame, after the
+// update and before rendering, so events published in a frame are seen by
+// the following draw. Not thread safe, events are published from the game
+// loop thread.
+//   bus.subscribe<&Hud::on_particle>(hud);
+//   bus.publish(ParticleEvent{});
+class EventBus
+{
+  std::vector<std::unique_ptr<EventQueueBase>> m_queues;
+
+ public:
+  template<typename Event>
+  EventQueue<Event>& queue()
+  {
+    auto const type = detail::event_type<Event>();
+    if (type >= m_queues.size()) {
+      m_queues.resize(type + 1);
+    }
+    auto& queue = m_queues[type];
+    if (queue == nullptr) {
+      queue = std::make_unique<EventQueue<Event>>();
+    }
+    return static_cast<EventQueue<Event>&>(*queue);
+  }
+
+  // preallocates room for capacity events of type Event per frame
+  template<typename Event>
+  void reserve(std::size_t capacity)
+  {
+    queue<Event>().reserve(capacity);
+  }
+
+  // Method is a member of T taking the event by const reference
+  template<auto Method, typename T>
+  void subscribe(T& instance)
+  {
+    using Event = typename detail::method_event<decltype(Method)>::type;
+    queue<Event>().subscribe(EventDelegate<Event>::template bind<Method>(
+        instance));
+  }
+
+  template<auto Method, typename T>
+  void unsubscribe(T& instance)
+  {
+    using Event = typename detail::method_event<decltype(Method)>::type;
+    queue<Event>().unsubscribe(EventDelegate<Event>::template bind<Method>(
+        instance));
+  }
+
+  // removes every delegate bound to instance, whatever the event type
+  void unsubscribe_all(void const* instance);
+
+  template<typename Event>
+  void publish(Event const& event)
+  {
+    queue<Event>().publish(event);
+  }
+
+  template<typename Event>
+  void send(Event const& event)
+  {
+    queue<Event>().send(event);
+  }
+
+  // delivers the events published before the call, events published while
+  // draining are left for the next drain. Returns how many were delivered
+  std::size_t drain();
+  [[nodiscard]] std::size_t pending() const;
+};
+
+} // namespace isaac
+
+#endif
@@ -2,11 +2,50 @@
 #define SYSTEM_LOGGER_HPP
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 namespace isaac {
 
+// Argument of a log message kept unformatted for structured sinks. Types
+// without a native alternative are formatted with "{}" when captured.
+using LogArg = std::variant<std::int64_t, std::uint64_t, double, bool,
+                            std::string_view, std::string>;
+
+template<typename T>
+LogArg to_log_arg(T const& value)
+{
+  if constexpr (std::is_same_v<T, bool>) {
+    return LogArg{std::in_place_type<bool>, value};
+  } else if constexpr (std::is_same_v<T, char>) {
+    return LogArg{std::in_place_type<std::string>, 1, value};
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    return LogArg{std::in_place_type<std::int64_t>, value};
+  } else if constexpr (std::is_integral_v<T>) {
+    return LogArg{std::in_place_type<std::uint64_t>, value};
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return LogArg{std::in_place_type<double>, value};
+  } else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+    return LogArg{std::in_place_type<std::string_view>, value};
+  } else {
+    return LogArg{std::in_place_type<std::string>, std::format("{}", value)};
+  }
+}
+
+// fmt with its replacement fields substituted in order by args
+std::string format_log_args(std::string_view fmt, std::span<LogArg const> args);
+
 class LoggerService
 {
  public:
@@ -21,7 +60,15 @@ class LoggerService
  protected:
   Level m_log_level;
   std::string m_fmt;
+  // set by sinks storing the arguments of a message rather than its text
+  bool m_structured = false;
   [[nodiscard]] std::string get_current_time() const;
+  [[nodiscard]] std::string
+  format_time(std::chrono::system_clock::time_point time) const;
+  // m_fmt applied to the second of time, cached per thread and valid until
+  // the next call from the same thread
+  [[nodiscard]] std::string_view
+  format_second(std::chrono::system_clock::time_point time) const;
 
   static constexpr std::array k_levels{"DEBUG", "INFO", "WARN", "ERROR"};
 
@@ -30,11 +77,23 @@ class LoggerService
                          std::string fmt = "%Y-%m-%d %H:%M:%S");
   virtual ~LoggerService() = default;
 
+  [[nodiscard]] bool enabled(Level log_level) const
+  {
+    return log_level >= m_log_level;
+  }
+  [[nodiscard]] bool structured() const
+  {
+    return m_structured;
+  }
+
   virtual void log(std::string_view const& msg, Level log_level) const = 0;
   virtual void debug(std::string_view const& msg) const                = 0;
   virtual void info(std::string_view const& msg) const                 = 0;
   virtual void warn(std::string_view const& msg) const                 = 0;
   virtual void error(std::string_view const& msg) const                = 0;
+  // formats the message and logs it, unless the sink keeps the arguments
+  virtual void log_structured(Level log_level, std::string_view fmt,
+                              std::span<LogArg const> args) const;
 };
 
 class LoggerNull : public LoggerService
@@ -54,6 +113,12 @@ class LoggerNull : public LoggerService
 
 class Logger : public LoggerService
 {
+ protected:
+  [[nodiscard]] std::string
+  format_message(std::string_view msg, Level log_level,
+                 std::chrono::system_clock::time_point time) const;
+  static void write(std::string_view text);
+
  public:
   explicit Logger(Level log_level = INFO,
                   std::string fmt = "%Y-%m-%d %H:%M:%S");
@@ -63,5 +128,116 @@ class Logger : public LoggerService
   void warn(std::string_view const& msg) const override;
   void error(std::string_view const& msg) const override;
 };
+
+// Logger whose callers only copy the message into a bounded lock-free queue.
+// A background thread formats and writes the records, and drains the queue
+// before the logger is destroyed. Messages longer than k_max_message are
+// truncated.
+class AsyncLogger : public Logger
+{
+ public:
+  // what log() does when the queue is full
+  enum class Overflow
+  {
+    drop,  // discard the message, the count is reported once there is room
+    block, // wait for the writer thread to make room
+  };
+
+  static constexpr std::size_t k_capacity    = 1024;
+  static constexpr std::size_t k_max_message = 240;
+
+ private:
+  struct Record
+  {
+    // equals the queue position the slot is ready to be written for, plus
+    // one once the record is filled
+    std::atomic<std::size_t> sequence;
+    std::chrono::system_clock::time_point time;
+    Level level;
+    std::uint16_t size;
+    char text[k_max_message];
+  };
+
+  Overflow m_overflow;
+  std::unique_ptr<Record[]> m_records;
+  // next position reserved by a producer, and next one read by the writer
+  mutable std::atomic<std::size_t> m_tail{0};
+  std::atomic<std::size_t> m_head{0};
+  mutable std::atomic<std::size_t> m_dropped{0};
+  std::size_t m_dropped_reported = 0;
+  // wakes the writer thread when it sleeps on an empty queue
+  mutable std::atomic<std::uint32_t> m_signal{0};
+  std::atomic<bool> m_sleeping{false};
+  std::atomic<bool> m_stop{false};
+  std::thread m_writer;
+
+  bool push(std::string_view msg, Level log_level) const;
+  void wake() const;
+  [[nodiscard]] bool empty() const;
+  std::size_t drain();
+  void run();
+
+ public:
+  explicit AsyncLogger(Level log_level = INFO,
+                       std::string fmt   = "%Y-%m-%d %H:%M:%S",
+                       Overflow overflow = Overflow::drop);
+  ~AsyncLogger() override;
+  AsyncLogger(AsyncLogger const&)            = delete;
+  AsyncLogger& operator=(AsyncLogger const&) = delete;
+
+  void log(std::string_view const& msg, Level log_level) const override;
+  // waits until every message logged so far is written
+  void flush() const;
+  // messages discarded since the logger was created
+  [[nodiscard]] std::size_t dropped() const;
+};
+
+// Lowest level kept by the ISAAC_LOG macros, DEBUG is dropped from NDEBUG
+// builds unless ISAAC_LOG_LEVEL says otherwise
+#ifndef ISAAC_LOG_LEVEL
+#ifdef NDEBUG
+#define ISAAC_LOG_LEVEL 1
+#else
+#define ISAAC_LOG_LEVEL 0
+#endif
+#endif
+
+inline constexpr auto k_min_log_level =
+    static_cast<LoggerService::Level>(ISAAC_LOG_LEVEL);
+
+// Called by the ISAAC_LOG macros once the level is known to pass
+template<typename... Args>
+void log_format(LoggerService const& logger, LoggerService::Level log_level,
+                std::format_string<Args...> fmt, Args&&... args)
+{
+  if (logger.structured()) {
+    std::array<LogArg, sizeof...(Args)> const packed{to_log_arg(args)...};
+    logger.log_structured(log_level, fmt.get(), packed);
+  } else {
+    logger.log(std::format(fmt, std::forward<Args>(args)...), log_level);
+  }
+}
+
 } // namespace isaac
+
+// Logs a message only if its level passes both k_min_log_level and the
+// logger level. Otherwise the arguments are not evaluated, and below
+// k_min_log_level the call is compiled out. Structured sinks receive the
+// arguments instead of the formatted text.
+//   ISAAC_LOG_DEBUG(logger, "spawned {} at {}", name, position.x);
+#define ISAAC_LOG(logger, level, ...)                                          \
+  do {                                                                         \
+    constexpr auto isaac_log_level = ::isaac::LoggerService::level;            \
+    if constexpr (isaac_log_level >= ::isaac::k_min_log_level) {               \
+      auto const& isaac_logger = (logger);                                     \
+      if (isaac_logger.enabled(isaac_log_level)) {                             \
+        ::isaac::log_format(isaac_logger, isaac_log_level, __VA_ARGS__);       \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
+#define ISAAC_LOG_DEBUG(logger, ...) ISAAC_LOG(logger, DEBUG, __VA_ARGS__)
+#define ISAAC_LOG_INFO(logger, ...) ISAAC_LOG(logger, INFO, __VA_ARGS__)
+#define ISAAC_LOG_WARN(logger, ...) ISAAC_LOG(logger, WARN, __VA_ARGS__)
+#define ISAAC_LOG_ERROR(logger, ...) ISAAC_LOG(logger, ERROR, __VA_ARGS__)
+
 #endif
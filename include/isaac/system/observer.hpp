@@ -2,7 +2,12 @@
 #define SYSTEM_OBSERVER_HPP
 
 #include <algorithm>
-#include <iostream>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace isaac {
@@ -18,34 +23,135 @@ class Observer
                          EventType const& event) {};
 };
 
+// Subject safe to notify from several threads while observers are added or
+// removed, including by an observer from inside on_notify. The observer list
+// is copied on write: notify walks an immutable snapshot without locking,
+// and a replaced snapshot is freed once no notify is in flight. Changes apply
+// from the next notify. remove_observer returns once the notifications in
+// flight are over, so the observer may be destroyed right after, except when
+// called from inside on_notify: a notify already started may then still
+// reach it.
 template<typename EventType>
 class Observable
 {
-  std::vector<Observer<EventType>*> m_observers;
+  using Observers = std::vector<Observer<EventType>*>;
+
+  // notify calls in flight on this thread, of any Observable of EventType
+  inline static thread_local int t_notifying = 0;
+
+  // leaves the reader slot entered by notify, even if an observer throws
+  struct ReadGuard
+  {
+    std::atomic<std::size_t>& readers;
+
+    ~ReadGuard()
+    {
+      readers.fetch_sub(1, std::memory_order_release);
+      --t_notifying;
+    }
+  };
+
+  std::atomic<Observers const*> m_observers{nullptr};
+  // notify calls count themselves in the slot of the epoch they started in,
+  // remove_observer moves to the next epoch and waits for the previous slot
+  std::atomic<std::size_t> m_epoch{0};
+  std::array<std::atomic<std::size_t>, 2> m_readers{};
+  // guards the snapshots below, taken by add_observer and remove_observer
+  std::mutex m_mutex;
+  std::unique_ptr<Observers const> m_current;
+  std::vector<std::unique_ptr<Observers const>> m_retired;
+  // one remove_observer waits at a time, so the slots alternate
+  std::mutex m_wait_mutex;
+
+  void publish(std::unique_ptr<Observers const> observers)
+  {
+    m_observers.store(observers.get());
+    m_retired.push_back(std::move(m_current));
+    m_current = std::move(observers);
+    // a notify starting from now on loads the new snapshot, so with no
+    // reader registered none of the retired ones can be in use
+    if (m_readers[0].load() == 0 && m_readers[1].load() == 0) {
+      m_retired.clear();
+    }
+  }
+
+  ReadGuard enter()
+  {
+    while (true) {
+      auto const epoch = m_epoch.load();
+      auto& readers    = m_readers[epoch & 1];
+      readers.fetch_add(1);
+      // an epoch ending meanwhile may already be waited for, retry in the
+      // next one
+      if (m_epoch.load() == epoch) {
+        ++t_notifying;
+        return ReadGuard{readers};
+      }
+      readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  // waits for every notify that may have loaded an older snapshot
+  void wait_for_readers()
+  {
+    std::lock_guard lock{m_wait_mutex};
+    auto const epoch = m_epoch.fetch_add(1);
+    auto& readers    = m_readers[epoch & 1];
+    while (readers.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
 
  public:
-  void add_observer(Observer<EventType>& observer)
+  Observable()                             = default;
+  Observable(Observable const&)            = delete;
+  Observable& operator=(Observable const&) = delete;
+
+  // returns false if the observer was already registered
+  bool add_observer(Observer<EventType>& observer)
   {
-    if (std::find(m_observers.begin(), m_observers.end(), &observer)
-        != m_observers.end()) {
-      std::cerr << "observer already registered\n";
-      return;
+    std::lock_guard lock{m_mutex};
+    auto observers =
+        m_current ? std::make_unique<Observers>(*m_current)
+                  : std::make_unique<Observers>();
+    if (std::ranges::find(*observers, &observer) != observers->end()) {
+      return false;
     }
-    m_observers.push_back(&observer);
+    observers->push_back(&observer);
+    publish(std::move(observers));
+    return true;
   };
 
-  void remove_observer(Observer<EventType>& observer)
+  // returns false if the observer was not registered
+  bool remove_observer(Observer<EventType>& observer)
   {
-    auto n = std::erase(m_observers, &observer);
-    if (n == 0) {
-      std::cerr << "observer not found\n";
+    {
+      std::lock_guard lock{m_mutex};
+      if (!m_current) {
+        return false;
+      }
+      auto observers = std::make_unique<Observers>(*m_current);
+      if (std::erase(*observers, &observer) == 0) {
+        return false;
+      }
+      publish(std::move(observers));
     }
+    // the notify this thread is in would never end
+    if (t_notifying == 0) {
+      wait_for_readers();
+    }
+    return true;
   }
 
   void notify(EventType const& event)
   {
-    for (auto& o : m_observers)
-      o->on_notify(*this, event);
+    // registered before loading the snapshot, see publish()
+    auto const guard = enter();
+    if (auto const observers = m_observers.load()) {
+      for (auto const o : *observers) {
+        o->on_notify(*this, event);
+      }
+    }
   }
 };
 } // namespace isaac
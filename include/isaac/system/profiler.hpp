@@ -0,0 +1,139 @@
+#ifndef ISAAC_SYSTEM_PROFILER_HPP
+#define ISAAC_SYSTEM_PROFILER_HPP
+
+#include "isaac/system/trace.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace isaac {
+
+#ifdef ISAAC_PROFILER
+inline constexpr bool k_profiler = true;
+#else
+inline constexpr bool k_profiler = false;
+#endif
+
+// Collects nested timing zones and counters of the main thread, one frame at
+// a time, and shows the last one in an ImGui window. Recording starts once
+// enabled; while disabled a zone costs a single branch.
+class Profiler
+{
+ public:
+  using Clock = Tracer::Clock;
+
+  static constexpr std::size_t k_history   = 240;
+  static constexpr std::size_t k_max_zones = 4096;
+  static constexpr std::size_t k_max_depth = 16;
+  static constexpr auto k_no_zone          = static_cast<std::uint32_t>(-1);
+
+  struct Zone
+  {
+    char const* name;
+    std::uint32_t depth;
+    // the name comes from std::type_info and is demangled for display
+    bool type_name;
+    // relative to the beginning of the frame
+    Clock::duration begin;
+    Clock::duration end;
+  };
+
+  struct Frame
+  {
+    Clock::duration duration{};
+    std::vector<Zone> zones;
+    std::vector<std::pair<char const*, std::int64_t>> counters;
+    std::size_t dropped_zones = 0;
+  };
+
+ private:
+  inline static bool s_enabled = false;
+
+  Frame m_current{};
+  Frame m_last{};
+  Clock::time_point m_frame_start{};
+  std::vector<std::uint32_t> m_open{};
+  std::vector<float> m_history = std::vector<float>(k_history);
+  std::size_t m_history_head   = 0;
+  bool m_recording             = false;
+  bool m_paused                = false;
+
+ public:
+  static Profiler& instance();
+  static void set_enabled(bool enabled);
+  [[nodiscard]] static bool enabled()
+  {
+    return s_enabled;
+  }
+
+  void begin_frame();
+  void end_frame();
+  std::uint32_t begin_zone(char const* name, bool type_name = false);
+  void end_zone(std::uint32_t zone);
+  // adds value to the named counter of the current frame
+  void count(char const* name, std::int64_t value);
+
+  [[nodiscard]] Frame const& last_frame() const;
+  void draw_window();
+};
+
+// Zone of the frame profiler, also recorded in the trace when tracing
+class ProfileZone
+{
+  TraceZone m_trace;
+  std::uint32_t m_zone = Profiler::k_no_zone;
+
+ public:
+  explicit ProfileZone(char const* name)
+      : m_trace{name}
+  {
+    if (Profiler::enabled()) {
+      m_zone = Profiler::instance().begin_zone(name);
+    }
+  }
+  // named after the dynamic type, e.g. the GameObject being updated
+  explicit ProfileZone(std::type_info const& type)
+      : m_trace{type}
+  {
+    if (Profiler::enabled()) {
+      m_zone = Profiler::instance().begin_zone(type.name(), true);
+    }
+  }
+  ~ProfileZone()
+  {
+    if (m_zone != Profiler::k_no_zone) {
+      Profiler::instance().end_zone(m_zone);
+    }
+  }
+  ProfileZone(ProfileZone const&)            = delete;
+  ProfileZone& operator=(ProfileZone const&) = delete;
+};
+
+} // namespace isaac
+
+// Zones last until the end of the enclosing scope and must be opened on the
+// main thread. Compiled out entirely without ISAAC_PROFILER.
+#ifdef ISAAC_PROFILER
+#define ISAAC_PROFILE_ZONE(name)                                               \
+  ::isaac::ProfileZone ISAAC_PROFILE_CONCAT(isaac_profile_zone_, __LINE__)     \
+  {                                                                            \
+    name                                                                       \
+  }
+#define ISAAC_PROFILE_FUNCTION() ISAAC_PROFILE_ZONE(__func__)
+#define ISAAC_PROFILE_COUNTER(name, value)                                     \
+  do {                                                                         \
+    if (::isaac::Profiler::enabled()) {                                        \
+      ::isaac::Profiler::instance().count(name, value);                        \
+    }                                                                          \
+  } while (false)
+#else
+#define ISAAC_PROFILE_ZONE(name) static_cast<void>(0)
+#define ISAAC_PROFILE_FUNCTION() static_cast<void>(0)
+#define ISAAC_PROFILE_COUNTER(name, value) static_cast<void>(0)
+#endif
+
+#endif
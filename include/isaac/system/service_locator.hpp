@@ -21,10 +21,11 @@ class ServiceLocator
     return m_service;
   }
 
-  template<typename... Args>
+  // Impl selects an implementation derived from T
+  template<typename Impl = T, typename... Args>
   static std::unique_ptr<T> register_service(Args... args)
   {
-    auto service = std::make_unique<T>(args...);
+    auto service = std::make_unique<Impl>(args...);
     m_service    = service.get();
     return service;
   }
@@ -1,26 +1,154 @@
 #ifndef SYSTEM_THREAD_HPP
 #define SYSTEM_THREAD_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace isaac {
 
-template<typename... Args>
-class thread_guard
+// A range [0, count) split in blocks of at least `block` items. The callback
+// matches b2TaskCallback so Box2D tasks can be forwarded without wrapping.
+struct ParallelJob
 {
-  std::thread m_t;
+  using Fn = void(int begin, int end, std::uint32_t worker, void* context);
+
+  Fn* fn        = nullptr;
+  void* context = nullptr;
+  int count     = 0;
+  int block     = 1;
+  std::atomic<int> next{0};
+  std::atomic<int> done{0};
+  // workers currently holding the job, guards against reusing it too early
+  std::atomic<int> active{0};
+
+  void reset(Fn* job_fn, void* job_context, int item_count, int min_block);
+  // runs blocks until none is left, returns false if nothing was claimed
+  bool run(std::uint32_t worker);
+  [[nodiscard]] bool finished() const;
+};
+
+// Fixed set of worker threads executing ParallelJobs. The thread submitting
+// and waiting on jobs takes part in the work as worker 0, so jobs must be
+// submitted from a single thread at a time.
+class WorkerPool
+{
+  std::vector<std::thread> m_threads;
+  std::deque<ParallelJob*> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop = false;
+
+  void work(std::uint32_t worker);
+
+ public:
+  explicit WorkerPool(std::size_t worker_count);
+  ~WorkerPool();
+  WorkerPool(WorkerPool const&)            = delete;
+  WorkerPool& operator=(WorkerPool const&) = delete;
+
+  // number of workers, the calling thread included
+  [[nodiscard]] std::size_t size() const;
+  void submit(ParallelJob& job);
+  void wait(ParallelJob& job);
+};
+
+// Number of jobs of a group still running, JobSystem::wait blocks on it. The
+// first exception thrown by one of the jobs is rethrown by wait
+class JobCounter
+{
+  std::atomic<int> m_pending{0};
+  std::atomic<bool> m_failed{false};
+  std::exception_ptr m_error;
+
+  friend class JobSystem;
 
  public:
-  explicit thread_guard(Args... args)
-      : m_t{args...} {};
-  ~thread_guard()
+  JobCounter()                             = default;
+  JobCounter(JobCounter const&)            = delete;
+  JobCounter& operator=(JobCounter const&) = delete;
+
+  [[nodiscard]] bool done() const;
+};
+
+// Items [begin, end) handed to fn. A job larger than grain is split in
+// halves, one half left in the queue of its worker for others to steal
+struct Job
+{
+  using Fn = void(int begin, int end, void* context);
+
+  Fn* fn              = nullptr;
+  void* context       = nullptr;
+  int begin           = 0;
+  int end             = 0;
+  int grain           = 1;
+  JobCounter* counter = nullptr;
+};
+
+// Work-stealing thread pool. Every worker owns a queue: it pushes and pops
+// jobs at the back, and steals from the front of the others' queues once its
+// own is empty. A thread waiting on a counter runs jobs until the counter
+// reaches zero, so jobs may submit and wait on nested jobs. Threads that are
+// not workers of the pool share the queue of worker 0.
+class JobSystem
+{
+  struct Queue
   {
-    join();
-  }
-  void join()
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  // jobs in all the queues, idle workers sleep while it is zero
+  std::atomic<int> m_queued{0};
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop = false;
+
+  [[nodiscard]] std::size_t current_worker() const;
+  void push(std::size_t worker, Job const& job);
+  bool pop(std::size_t worker, Job& job);
+  void execute(std::size_t worker, Job job);
+  void work(std::size_t worker);
+
+ public:
+  // 0 uses every hardware thread, the calling thread included
+  explicit JobSystem(std::size_t worker_count = 0);
+  ~JobSystem();
+  JobSystem(JobSystem const&)            = delete;
+  JobSystem& operator=(JobSystem const&) = delete;
+
+  // number of workers, the calling thread included
+  [[nodiscard]] std::size_t size() const;
+  // queues fn over [0, count), to be waited on with counter
+  void run(JobCounter& counter, Job::Fn* fn, void* context, int count,
+           int grain = 1);
+  void wait(JobCounter& counter);
+
+  // calls fn(begin, end) over [0, count) in ranges of at least grain items,
+  // returns once every item is done
+  template<typename F>
+  void parallel_for(int count, int grain, F&& fn)
   {
-    if (m_t.joinable())
-      m_t.join();
+    using Callable = std::remove_reference_t<F>;
+    JobCounter counter;
+    run(
+        counter,
+        [](int begin, int end, void* context) {
+          (*static_cast<Callable*>(context))(begin, end);
+        },
+        const_cast<void*>(static_cast<void const*>(std::addressof(fn))),
+        count, grain);
+    wait(counter);
   }
 };
 
@@ -0,0 +1,128 @@
+#ifndef ISAAC_SYSTEM_TRACE_HPP
+#define ISAAC_SYSTEM_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+namespace isaac {
+
+// Records timed events into one ring buffer per thread and writes them in
+// the Chrome Trace Event format, opened by chrome://tracing and
+// ui.perfetto.dev. Each buffer keeps the last k_capacity events of its
+// thread; recording never locks, only the first event of a thread does.
+class Tracer
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // about a dozen frames of a scene of 10k objects, each one updating in a
+  // zone of its own
+  static constexpr std::size_t k_capacity = 1 << 17;
+
+  struct Event
+  {
+    char const* name = nullptr;
+    // the name comes from std::type_info and is demangled when written
+    bool type_name = false;
+    Clock::time_point begin{};
+    Clock::time_point end{};
+  };
+
+ private:
+  struct Buffer;
+
+  inline static std::atomic<bool> s_enabled{false};
+  static thread_local Buffer* t_buffer;
+
+  // guards m_buffers, a thread registers its buffer once
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<Buffer>> m_buffers;
+  std::filesystem::path m_path;
+  Clock::time_point m_epoch{};
+
+  Tracer();
+  Buffer& local_buffer();
+
+ public:
+  ~Tracer();
+  Tracer(Tracer const&)            = delete;
+  Tracer& operator=(Tracer const&) = delete;
+
+  static Tracer& instance();
+  [[nodiscard]] static bool enabled()
+  {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+  // names the calling thread in the trace, before it records anything
+  static void set_thread_name(char const* name);
+
+  // events older than the last start() are not written
+  void start(std::filesystem::path path = "isaac_trace.json");
+  void stop();
+  void record(char const* name, bool type_name, Clock::time_point begin,
+              Clock::time_point end);
+  // writes the buffered events to the path given to start(). Safe while
+  // other threads record, the events they overwrite meanwhile are left out
+  bool flush();
+  bool flush(std::filesystem::path const& path);
+  [[nodiscard]] std::filesystem::path const& path() const;
+};
+
+// Records an event for the enclosing scope, from any thread
+class TraceZone
+{
+  char const* m_name = nullptr;
+  bool m_type_name   = false;
+  Tracer::Clock::time_point m_begin{};
+
+ public:
+  explicit TraceZone(char const* name)
+  {
+    if (Tracer::enabled()) {
+      m_name  = name;
+      m_begin = Tracer::Clock::now();
+    }
+  }
+  explicit TraceZone(std::type_info const& type)
+  {
+    if (Tracer::enabled()) {
+      m_name      = type.name();
+      m_type_name = true;
+      m_begin     = Tracer::Clock::now();
+    }
+  }
+  ~TraceZone()
+  {
+    if (m_name != nullptr) {
+      Tracer::instance().record(m_name, m_type_name, m_begin,
+                                Tracer::Clock::now());
+    }
+  }
+  TraceZone(TraceZone const&)            = delete;
+  TraceZone& operator=(TraceZone const&) = delete;
+};
+
+} // namespace isaac
+
+#define ISAAC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ISAAC_PROFILE_CONCAT(a, b) ISAAC_PROFILE_CONCAT_IMPL(a, b)
+
+// Only recorded in the trace, unlike ISAAC_PROFILE_ZONE it can be used on
+// any thread. Compiled out without ISAAC_PROFILER.
+#ifdef ISAAC_PROFILER
+#define ISAAC_TRACE_ZONE(name)                                                 \
+  ::isaac::TraceZone ISAAC_PROFILE_CONCAT(isaac_trace_zone_, __LINE__)         \
+  {                                                                            \
+    name                                                                       \
+  }
+#else
+#define ISAAC_TRACE_ZONE(name) static_cast<void>(0)
+#endif
+
+#endif
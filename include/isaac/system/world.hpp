@@ -9,8 +9,14 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/System/Clock.hpp>
 
+#include <cstddef>
+#include <vector>
+
 namespace isaac {
 
+class EventBus;
+class GameObject;
+class JobSystem;
 class SceneManager;
 class PhysicsServer2D;
 
@@ -18,23 +24,41 @@ class World : public Observable<sf::Event>
 {
   sf::Clock m_frame_clock{};
   sf::Time m_frame_time{};
+  sf::Time m_fixed_delta{};
+  sf::Time m_accumulator{};
+  float m_alpha   = 1.f;
+  bool m_headless = false;
+  bool m_running  = false;
   SceneManager& m_scene_manager;
   sf::RenderWindow& m_window;
   PhysicsServer2D& m_physics_server_2d;
+  EventBus& m_event_bus;
+  JobSystem& m_jobs;
   Logger& m_logger;
+  // top-level objects whose subtree has parallel updates, reused every step
+  std::vector<GameObject*> m_parallel_subtrees{};
 
   void input();
   void update();
+  void step(float delta);
+  void update_parallel(GameObject& root, float delta);
+  void dispatch_events();
   void render();
   void destroy_queued();
+  [[nodiscard]] bool running() const;
 
  public:
   World(WindowServer& window_server, SceneManager& scene_manager,
         PhysicsServer2D& physics_server);
   ~World();
   void start();
-  void game_loop();
+  // runs until the window is closed or stop() is called, or for the given
+  // number of ticks when non zero
+  void game_loop(std::size_t ticks = 0);
+  void stop();
   void clear();
+  void set_fixed_update_rate(float update_rate);
+  [[nodiscard]] bool fixed_timestep() const;
 };
 } // namespace isaac
 #endif
@@ -1,10 +1,14 @@
 #include "isaac/components/collision_body_2d.hpp"
+#include "isaac/components/game_object.hpp"
 #include "isaac/system/templates.hpp"
 
 #include <SFML/System/Vector2.hpp>
+#include <box2d/box2d.h>
 #include <box2d/math_functions.h>
 #include <box2d/types.h>
 
+#include <cstdint>
+
 namespace isaac {
 
 CollisionBody2D::CollisionBody2D(CollisionShape collision_shape)
@@ -12,6 +16,8 @@ CollisionBody2D::CollisionBody2D(CollisionShape collision_shape)
     , m_body_def{b2DefaultBodyDef()}
     , m_body_id{}
 {
+  // lets PhysicsServer2D map Box2D events back to the component
+  m_body_def.userData = reinterpret_cast<void*>(handle().pointer_value());
   auto const visitor = overloads{
       [&](Box2DShape const& shape) {
         m_offset = sf::Vector2f{shape.size().x, shape.size().y} * 0.5f;
@@ -23,6 +29,49 @@ CollisionBody2D::CollisionBody2D(CollisionShape collision_shape)
   std::visit(visitor, m_collision_shape);
 }
 
+CollisionBody2D::~CollisionBody2D()
+{
+  if (b2Body_IsValid(m_body_id)) {
+    b2DestroyBody(m_body_id);
+  }
+}
+
+CollisionBody2D* CollisionBody2D::from_user_data(void* user_data)
+{
+  auto const value = reinterpret_cast<std::uintptr_t>(user_data);
+  return static_cast<CollisionBody2D*>(
+      ObjectRegistry::instance().from_pointer_value(value));
+}
+
+void CollisionBody2D::sync_transform(b2Transform const& transform)
+{
+  // the body sits at the centre of the shape, the object at its corner
+  auto const offset = b2RotateVector(transform.q, {m_offset.x, m_offset.y});
+  auto& go          = *game_object();
+  go.set_global_rotation(sf::radians(b2Rot_GetAngle(transform.q)));
+  go.set_global_position({transform.p.x - offset.x, transform.p.y - offset.y});
+}
+
+void CollisionBody2D::enable(GameObject& go)
+{
+  auto const transform = body_transform(go);
+  b2Body_SetTransform(m_body_id, transform.p, transform.q);
+  b2Body_Enable(m_body_id);
+}
+
+void CollisionBody2D::disable(GameObject&)
+{
+  b2Body_Disable(m_body_id);
+}
+
+b2Transform CollisionBody2D::body_transform(GameObject const& go) const
+{
+  auto const position = go.get_global_position();
+  auto const rotation = b2MakeRot(go.get_global_rotation().asRadians());
+  auto const offset   = b2RotateVector(rotation, {m_offset.x, m_offset.y});
+  return {{position.x + offset.x, position.y + offset.y}, rotation};
+}
+
 b2BodyDef const& CollisionBody2D::body_def() const
 {
   return m_body_def;
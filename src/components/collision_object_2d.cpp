@@ -2,7 +2,6 @@
 #include "isaac/physics/collision_shape_2d.hpp"
 #include "isaac/physics/physics_2d.hpp"
 #include "isaac/system/service_locator.hpp"
-#include "isaac/system/templates.hpp"
 
 #include <box2d/box2d.h>
 
@@ -19,23 +18,9 @@ CollisionObject2D::CollisionObject2D(CollisionShape collision_shape)
 
 void CollisionObject2D::update(GameObject& go)
 {
-  auto const visitor = overloads{
-      [&](Box2DShape& shape) {
-        auto transform = b2Body_GetTransform(m_body_id);
-        auto half_size = shape.size() * 0.5f;
-        b2Vec2 pos{go.get_global_position().x, go.get_global_position().y};
-        auto rotation = b2Body_GetRotation(m_body_id);
-        b2Body_SetTransform(m_body_id, pos + half_size, rotation);
-      },
-      [&](Circle2DShape& shape) {
-        auto transform = b2Body_GetTransform(m_body_id);
-        auto r         = shape.get_radius();
-        b2Vec2 pos{go.get_global_position().x + r,
-                   go.get_global_position().y + r};
-        auto rotation = b2Body_GetRotation(m_body_id);
-        b2Body_SetTransform(m_body_id, pos, rotation);
-      }};
-  std::visit(visitor, m_collision_shape);
+  // m_offset is the half size of a box and the radius of a circle
+  auto const transform = body_transform(go);
+  b2Body_SetTransform(m_body_id, transform.p, transform.q);
 }
 
 } // namespace isaac
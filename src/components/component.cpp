@@ -2,8 +2,27 @@
 #include "isaac/components/game_object.hpp"
 
 namespace isaac {
+void ComponentDeleter::operator()(Component* component) const
+{
+  if (release) {
+    release(component);
+  } else {
+    delete component;
+  }
+}
+
 GameObject* Component::game_object()
 {
   return m_parent;
 }
+
+bool Component::pooled() const
+{
+  return m_pool_index != k_not_pooled;
+}
+
+bool Component::active() const
+{
+  return m_active;
+}
 } // namespace isaac
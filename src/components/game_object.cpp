@@ -1,8 +1,11 @@
 #include "isaac/components/game_object.hpp"
+#include "isaac/components/shape_renderer.hpp"
+#include "isaac/system/profiler.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <ranges>
+#include <typeinfo>
 
 namespace isaac {
 
@@ -11,72 +14,314 @@ void GameObject::start()
   on_start();
   std::ranges::for_each(m_components, [&](auto& comp) { comp->start(*this); });
   std::ranges::for_each(m_children, [](auto& child) { child->start(); });
+  // a freshly started object has no previous state to interpolate from
+  m_transform.previous_world = get_global_transform();
+  m_transform.render         = m_transform.previous_world;
 }
 
 void GameObject::update(float delta)
 {
+  if (!m_enabled) {
+    return;
+  }
+  // also the trace event of the object, one per object and step
+  ISAAC_PROFILE_ZONE(typeid(*this));
   on_update(delta);
-  update_children_positions();
-  std::ranges::for_each(m_components,
-                        [this](auto& comp) { comp->update(*this); });
+  std::ranges::for_each(m_components, [this](auto& comp) {
+    if (!comp->pooled()) {
+      comp->update(*this);
+    }
+  });
   std::ranges::for_each(m_children, [&](auto& child) { child->update(delta); });
 }
 
-void GameObject::draw(sf::RenderWindow& window)
+// the parallel pass of the subtree, see World::update_parallel
+void GameObject::update_parallel(float delta)
+{
+  if (!m_enabled) {
+    return;
+  }
+  if (m_parallel_update) {
+    ISAAC_TRACE_ZONE("on_parallel_update");
+    on_parallel_update(delta);
+  }
+  if (!m_parallel_children) {
+    return;
+  }
+  // recomputed on the way, the flag goes stale once the objects opting in
+  // are destroyed or opt out
+  m_parallel_children = false;
+  for (auto const& child : m_children) {
+    if (child->m_parallel_update || child->m_parallel_children) {
+      child->update_parallel(delta);
+      m_parallel_children = m_parallel_children || child->m_parallel_update
+                            || child->m_parallel_children;
+    }
+  }
+}
+
+void GameObject::save_transform()
+{
+  m_transform.previous_world = m_transform.world;
+  std::ranges::for_each(m_children,
+                        [](auto& child) { child->save_transform(); });
+}
+
+void GameObject::mark_transform_dirty()
+{
+  m_transform_dirty = true;
+  // ancestors already flagged have flagged theirs too
+  for (auto go = m_parent; go != nullptr && !go->m_children_dirty;
+       go = go->m_parent) {
+    go->m_children_dirty = true;
+  }
+}
+
+void GameObject::mark_parallel_update()
+{
+  for (auto go = m_parent; go != nullptr && !go->m_parallel_children;
+       go = go->m_parent) {
+    go->m_parallel_children = true;
+  }
+}
+
+// refreshes the world matrices of moved objects and their descendants, one
+// level of the hierarchy at a time so each level is composed in a batch.
+// Subtrees where nothing moved are skipped
+void GameObject::propagate_transform()
+{
+  if (!m_transform_dirty && !m_children_dirty) {
+    return;
+  }
+  // reused between frames, only the game loop thread propagates
+  static std::vector<GameObject*> level;
+  static std::vector<GameObject*> next;
+  static std::vector<GameObject*> moved;
+  static MatrixArray parents;
+  static MatrixArray locals;
+  static MatrixArray worlds;
+  // whether the parent of each object in level was moved
+  static std::vector<bool> parent_moved;
+  static std::vector<bool> next_parent_moved;
+
+  level.assign(1, this);
+  parent_moved.assign(1, false);
+  while (!level.empty()) {
+    moved.clear();
+    for (std::size_t i = 0; i < level.size(); ++i) {
+      if (parent_moved[i] || level[i]->m_transform_dirty) {
+        moved.push_back(level[i]);
+      }
+    }
+    parents.resize(moved.size());
+    locals.resize(moved.size());
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+      auto const parent = moved[i]->m_parent;
+      parents.set(i, parent ? parent->m_transform.world : Matrix2D{});
+      locals.set(i, moved[i]->m_transform.local);
+    }
+    compose(parents, locals, worlds);
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+      moved[i]->m_transform.world = worlds.get(i);
+    }
+
+    next.clear();
+    next_parent_moved.clear();
+    for (std::size_t i = 0; i < level.size(); ++i) {
+      auto& go         = *level[i];
+      auto const moves = parent_moved[i] || go.m_transform_dirty;
+      if (moves || go.m_children_dirty) {
+        for (auto const& child : go.m_children) {
+          if (moves || child->m_transform_dirty || child->m_children_dirty) {
+            next.push_back(child.get());
+            next_parent_moved.push_back(moves);
+          }
+        }
+      }
+      go.m_transform_dirty = false;
+      go.m_children_dirty  = false;
+    }
+    std::swap(level, next);
+    std::swap(parent_moved, next_parent_moved);
+  }
+}
+
+void GameObject::set_local_matrix()
+{
+  m_transform.local = Matrix2D::from(m_transform.position, m_transform.rotation,
+                                     m_transform.scale);
+  mark_transform_dirty();
+}
+
+void GameObject::draw(sf::RenderWindow& window, float alpha)
 {
+  if (!m_enabled) {
+    return;
+  }
+  auto const& previous = m_transform.previous_world;
+  auto const& current  = m_transform.world;
+  if (previous == current || alpha >= 1.f) {
+    m_transform.render = current;
+  } else {
+    auto const lerp = [&](auto a, auto b) { return a + (b - a) * alpha; };
+    // the rotation takes the shortest way round
+    auto const from  = previous.rotation();
+    auto const delta = (current.rotation() - from).wrapSigned();
+    m_transform.render =
+        Matrix2D::from(lerp(previous.translation(), current.translation()),
+                       from + delta * alpha,
+                       lerp(previous.scale(), current.scale()));
+  }
+  if (m_custom_draw) {
+    // keeps the tree order, what was batched so far goes below
+    ShapeRenderer::flush(window);
+  }
   on_draw(window);
+  // pooled components too, the shape batch follows the tree order
   std::ranges::for_each(m_components,
-                        [&](auto& child) { child->draw(*this, window); });
-  std::ranges::for_each(m_children, [&](auto& child) { child->draw(window); });
+                        [&](auto& comp) { comp->draw(*this, window); });
+  std::ranges::for_each(m_children,
+                        [&](auto& child) { child->draw(window, alpha); });
+}
+
+void GameObject::on_draw(sf::RenderWindow&)
+{
+  m_custom_draw = false;
 }
 
 void GameObject::destroy_queued()
 {
-  // recursively destroy_queued children
-  std::ranges::for_each(m_children,
-                        [](auto& child) { child->destroy_queued(); });
+  auto& registry = ObjectRegistry::instance();
+  static std::vector<ObjectHandle> parents;
+  static std::vector<GameObject_ptr> destroyed;
 
-  auto to_erase = std::ranges::partition(m_children, [&](auto& child) {
-    return !m_child_ids_to_erase.contains(child->id());
-  });
+  // each parent owning a destroyed child compacts its children once
+  for (auto handle : s_destroy_queue) {
+    auto const go = static_cast<GameObject*>(registry.get(handle));
+    if (go != nullptr && !go->m_parent->m_compact_queued) {
+      go->m_parent->m_compact_queued = true;
+      parents.push_back(go->m_parent->handle());
+    }
+  }
+  s_destroy_queue.clear();
+
+  for (auto handle : parents) {
+    auto const parent = static_cast<GameObject*>(registry.get(handle));
+    if (parent == nullptr) {
+      continue;
+    }
+    parent->m_compact_queued = false;
+    for (auto& child : parent->m_children) {
+      if (child->m_destroy_queued) {
+        destroyed.push_back(std::move(child));
+      }
+    }
+    std::erase(parent->m_children, nullptr);
+  }
+  parents.clear();
+  ISAAC_PROFILE_COUNTER("objects destroyed", destroyed.size());
 
-  std::ranges::for_each(to_erase, [](auto& child) { child->on_destroy(); });
-  m_children.erase(to_erase.begin(), to_erase.end());
-  m_child_ids_to_erase.clear();
+  // destroyed objects stay alive until every parent has been compacted, so
+  // a destroyed child of a destroyed parent is still notified
+  std::ranges::for_each(destroyed, [](auto& go) { go->on_destroy(); });
+  destroyed.clear();
 }
 
 void GameObject::enable()
 {
-  std::ranges::for_each(m_children, [](auto& child) { child->enable(); });
+  if (m_enabled) {
+    return;
+  }
   m_enabled = true;
+  if (active()) {
+    set_active(true);
+  }
 }
 
 void GameObject::disable()
 {
-  std::ranges::for_each(m_children, [](auto& child) { child->disable(); });
-  m_enabled = false;
+  if (!m_enabled) {
+    return;
+  }
+  auto const was_active = active();
+  m_enabled             = false;
+  if (was_active) {
+    set_active(false);
+  }
 }
 
 bool GameObject::enabled() const
 {
-  return !m_enabled;
+  return m_enabled;
+}
+
+bool GameObject::active() const
+{
+  for (auto go = this; go != nullptr; go = go->m_parent) {
+    if (!go->m_enabled) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// notifies the subtree, children disabled on their own stay as they are
+void GameObject::set_active(bool active)
+{
+  if (active) {
+    on_enable();
+  } else {
+    on_disable();
+  }
+  for (auto& comp : m_components) {
+    comp->m_active = active;
+    if (active) {
+      comp->enable(*this);
+    } else {
+      comp->disable(*this);
+    }
+  }
+  if (active) {
+    // a recycled object does not interpolate from where it was parked
+    m_transform.previous_world = get_global_transform();
+    m_transform.render         = m_transform.previous_world;
+  }
+  for (auto& child : m_children) {
+    if (child->m_enabled) {
+      child->set_active(active);
+    }
+  }
+}
+
+void GameObject::set_parallel_update(bool enabled)
+{
+  m_parallel_update = enabled;
+  if (enabled) {
+    mark_parallel_update();
+  }
+}
+
+bool GameObject::parallel_update() const
+{
+  return m_parallel_update;
 }
 
 void GameObject::destroy()
 {
   assert(m_parent && "parent is null");
-  m_parent->m_child_ids_to_erase.emplace(id());
+  if (!m_destroy_queued) {
+    m_destroy_queued = true;
+    s_destroy_queue.push_back(handle());
+  }
 }
 
 void GameObject::set_position(sf::Vector2f const& position)
 {
-  if (m_parent) {
-    m_transform.global_position = m_parent->get_global_position() + position;
-  } else {
-    m_transform.global_position = position;
-  }
+  // the translation is the only part of the local matrix it changes
   m_transform.position = position;
-  update_children_positions();
+  m_transform.local.tx = position.x;
+  m_transform.local.ty = position.y;
+  mark_transform_dirty();
 }
 
 sf::Vector2f GameObject::get_position() const
@@ -86,21 +331,79 @@ sf::Vector2f GameObject::get_position() const
 
 void GameObject::set_global_position(sf::Vector2f const& position)
 {
-  m_transform.global_position = position;
-  update_children_positions();
+  // stored as the local position, the world matrix follows on propagation
+  set_position(m_parent
+                   ? m_parent->get_global_transform().inverse().transform_point(
+                         position)
+                   : position);
 }
 
 sf::Vector2f GameObject::get_global_position() const
 {
-  return m_transform.global_position;
+  return get_global_transform().translation();
 }
 
-void GameObject::update_children_positions() const
+void GameObject::set_rotation(sf::Angle rotation)
 {
-  std::ranges::for_each(m_children, [&](auto& child) {
-    child->set_global_position(m_transform.global_position
-                               + child->get_position());
-  });
+  m_transform.rotation = rotation;
+  set_local_matrix();
+}
+
+sf::Angle GameObject::get_rotation() const
+{
+  return m_transform.rotation;
+}
+
+void GameObject::set_global_rotation(sf::Angle rotation)
+{
+  set_rotation(m_parent ? rotation - m_parent->get_global_rotation()
+                        : rotation);
+}
+
+sf::Angle GameObject::get_global_rotation() const
+{
+  return get_global_transform().rotation();
+}
+
+void GameObject::set_scale(sf::Vector2f const& scale)
+{
+  m_transform.scale = scale;
+  set_local_matrix();
+}
+
+sf::Vector2f GameObject::get_scale() const
+{
+  return m_transform.scale;
+}
+
+Matrix2D GameObject::get_global_transform() const
+{
+  // the cache is stale below the highest dirty ancestor, whose parent is
+  // clean, so the locals up to it are composed onto that parent's cache
+  GameObject const* top = nullptr;
+  for (auto go = this; go != nullptr; go = go->m_parent) {
+    if (go->m_transform_dirty) {
+      top = go;
+    }
+  }
+  if (top == nullptr) {
+    return m_transform.world;
+  }
+  auto world = m_transform.local;
+  for (auto go = this; go != top; go = go->m_parent) {
+    world = go->m_parent->m_transform.local * world;
+  }
+  return top->m_parent ? top->m_parent->m_transform.world * world : world;
+}
+
+sf::Vector2f GameObject::get_render_position() const
+{
+  return m_transform.render.translation();
+}
+
+Matrix2D const& GameObject::get_render_transform() const
+{
+  return m_transform.render;
 }
 
 std::vector<GameObject_ptr>& GameObject::get_children()
@@ -18,28 +18,27 @@ RigidBody2D::RigidBody2D(CollisionShape collision_shape)
 
 void RigidBody2D::start(GameObject& go)
 {
-  auto transform = b2Body_GetTransform(m_body_id);
-  b2Vec2 pos{go.get_global_position().x, go.get_global_position().y};
-  auto rotation = b2Body_GetRotation(m_body_id);
-  b2Vec2 offset{m_offset.x, m_offset.y};
-  b2Body_SetTransform(m_body_id, pos + offset, rotation);
+  auto const transform = body_transform(go);
+  b2Body_SetTransform(m_body_id, transform.p, transform.q);
 }
 
-void RigidBody2D::update(GameObject& go)
+void RigidBody2D::enable(GameObject& go)
 {
-  auto transform = b2Body_GetTransform(m_body_id);
-  sf::Vector2 pos{transform.p.x, transform.p.y};
-  go.set_global_position(pos - m_offset);
+  // Box2D ignores velocities set on a disabled body
+  CollisionBody2D::enable(go);
+  b2Body_SetLinearVelocity(m_body_id, b2Vec2_zero);
+  b2Body_SetAngularVelocity(m_body_id, 0.f);
 }
 
 void RigidBody2D::set_restitution(float restitution)
 {
-  std::visit(
-      [&](auto& shape) {
-        auto shape_id = shape.make_shape(m_body_id);
-        b2Shape_SetRestitution(shape_id, restitution);
-      },
-      m_collision_shape);
+  // a recycled body keeps its shape rather than stacking another one
+  if (!b2Shape_IsValid(m_shape_id)) {
+    m_shape_id = std::visit(
+        [&](auto& shape) { return shape.make_shape(m_body_id); },
+        m_collision_shape);
+  }
+  b2Shape_SetRestitution(m_shape_id, restitution);
 }
 
 } // namespace isaac
@@ -3,23 +3,112 @@
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace isaac {
 
-void ShapeRenderer::update(GameObject& game_object)
+namespace {
+
+sf::Shape const& base_shape(Shape const& shape)
 {
-  auto const go_pos = game_object.get_global_position();
-  for (auto&& shape : m_shapes) {
-    std::visit([&](auto& s) { s.setPosition(go_pos); }, shape);
+  return std::visit([](auto const& s) -> sf::Shape const& { return s; },
+                    shape);
+}
+
+} // namespace
+
+ShapeRenderer::ShapeState ShapeRenderer::state_of(sf::Shape const& shape)
+{
+  return {shape.getPointCount(),
+          shape.getLocalBounds(),
+          shape.getTexture(),
+          shape.getFillColor(),
+          shape.getOutlineColor(),
+          shape.getOutlineThickness(),
+          shape.getOrigin(),
+          shape.getScale(),
+          shape.getRotation()};
+}
+
+bool ShapeRenderer::geometry_stale() const
+{
+  if (m_states.size() != m_shapes.size()) {
+    return true;
   }
-  m_last_position = go_pos;
+  return !std::ranges::equal(m_shapes, m_states, [](auto& shape, auto& state) {
+    return state_of(base_shape(shape)) == state;
+  });
 }
 
-void ShapeRenderer::draw(GameObject& _, sf::RenderWindow& window)
+void ShapeRenderer::rebuild_geometry()
 {
+  m_states.clear();
+  m_geometry.clear();
+  m_ends.clear();
+  m_textured = false;
   for (auto&& shape : m_shapes) {
-    std::visit([&](auto& s) { window.draw(s); }, shape);
+    auto const& s = base_shape(shape);
+    m_states.push_back(state_of(s));
+    if (s.getTexture() != nullptr) {
+      m_textured = true;
+    } else {
+      ShapeBatch::tessellate(s, m_geometry);
+    }
+    m_ends.push_back(m_geometry.size());
+  }
+}
+
+void ShapeRenderer::append(std::span<sf::Vertex const> geometry,
+                           Matrix2D const& transform)
+{
+  // most objects are neither rotated nor scaled, a translation is enough
+  if (transform.a == 1.f && transform.b == 0.f && transform.c == 0.f
+      && transform.d == 1.f) {
+    s_batch.append(geometry, transform.translation());
+  } else {
+    s_batch.append(geometry, transform);
   }
 }
+
+void ShapeRenderer::draw(GameObject& game_object, sf::RenderWindow& window)
+{
+  if (geometry_stale()) {
+    rebuild_geometry();
+  }
+  auto const& transform = game_object.get_render_transform();
+  if (!m_textured) {
+    append(m_geometry, transform);
+    return;
+  }
+  // the shapes before a textured one are batched, then flushed below it
+  sf::RenderStates const states{transform.sf_transform()};
+  std::span<sf::Vertex const> const geometry{m_geometry};
+  std::size_t begin = 0;
+  for (std::size_t i = 0; i < m_shapes.size(); ++i) {
+    std::visit(
+        [&](auto& s) {
+          if (s.getTexture() == nullptr) {
+            return;
+          }
+          append(geometry.subspan(begin, m_ends[i] - begin), transform);
+          begin = m_ends[i];
+          s_batch.draw(window);
+          s.setPosition({});
+          window.draw(s, states);
+        },
+        m_shapes[i]);
+  }
+  append(geometry.subspan(begin), transform);
+}
+
+void ShapeRenderer::flush(sf::RenderTarget& target)
+{
+  s_batch.draw(target);
+}
+
+ShapeBatch& ShapeRenderer::batch()
+{
+  return s_batch;
+}
 } // namespace isaac
@@ -2,15 +2,44 @@
 
 namespace isaac {
 
-std::size_t BaseObject::s_instance_count{0};
-
 BaseObject::BaseObject()
+    : m_handle{ObjectRegistry::instance().insert(*this)}
+{}
+
+BaseObject::~BaseObject()
+{
+  ObjectRegistry::instance().erase(m_handle);
+}
+
+BaseObject::BaseObject(BaseObject const&)
+    : BaseObject{}
+{}
+
+BaseObject::BaseObject(BaseObject&& other)
+    : m_handle{other.m_handle}
 {
-  m_id = s_instance_count++;
+  auto& registry = ObjectRegistry::instance();
+  registry.rebind(m_handle, *this);
+  other.m_handle = registry.insert(other);
+}
+
+BaseObject& BaseObject::operator=(BaseObject const&)
+{
+  return *this;
+}
+
+BaseObject& BaseObject::operator=(BaseObject&&)
+{
+  return *this;
 }
 
 std::size_t isaac::BaseObject::id() const
 {
-  return m_id;
+  return m_handle.value();
+}
+
+ObjectHandle BaseObject::handle() const
+{
+  return m_handle;
 }
 } // namespace isaac
@@ -0,0 +1,26 @@
+#include "isaac/internal/demangle.hpp"
+
+#include <cstdlib>
+#include <memory>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define ISAAC_HAS_CXXABI
+#endif
+
+namespace isaac {
+
+std::string demangle(char const* name)
+{
+#ifdef ISAAC_HAS_CXXABI
+  int status = 0;
+  std::unique_ptr<char, decltype(&std::free)> demangled{
+      abi::__cxa_demangle(name, nullptr, nullptr, &status), &std::free};
+  if (status == 0) {
+    return demangled.get();
+  }
+#endif
+  return name;
+}
+
+} // namespace isaac
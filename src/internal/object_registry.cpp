@@ -0,0 +1,113 @@
+#include "isaac/internal/object_registry.hpp"
+
+#include <cassert>
+
+namespace isaac {
+
+namespace {
+
+constexpr bool k_wide_pointers =
+    sizeof(std::uintptr_t) >= sizeof(std::uint64_t);
+constexpr int k_packed_index_bits           = 24;
+constexpr std::uint32_t k_packed_index      = (1u << k_packed_index_bits) - 1;
+constexpr std::uint32_t k_packed_generation = 0xff;
+
+} // namespace
+
+std::uint64_t ObjectHandle::value() const
+{
+  return static_cast<std::uint64_t>(generation) << 32 | index;
+}
+
+ObjectHandle ObjectHandle::from_value(std::uint64_t value)
+{
+  return {static_cast<std::uint32_t>(value),
+          static_cast<std::uint32_t>(value >> 32)};
+}
+
+std::uintptr_t ObjectHandle::pointer_value() const
+{
+  if constexpr (k_wide_pointers) {
+    return static_cast<std::uintptr_t>(value());
+  } else {
+    assert(index <= k_packed_index && "too many objects to pack a handle");
+    return static_cast<std::uintptr_t>(
+        (generation & k_packed_generation) << k_packed_index_bits | index);
+  }
+}
+
+ObjectRegistry& ObjectRegistry::instance()
+{
+  static ObjectRegistry registry;
+  return registry;
+}
+
+ObjectHandle ObjectRegistry::insert(BaseObject& object)
+{
+  std::uint32_t index;
+  if (m_free_head != ObjectHandle::k_invalid) {
+    index       = m_free_head;
+    m_free_head = m_slots[index].next_free;
+  } else {
+    index = static_cast<std::uint32_t>(m_slots.size());
+    m_slots.emplace_back();
+  }
+  auto& slot  = m_slots[index];
+  slot.object = &object;
+  ++m_size;
+  return {index, slot.generation};
+}
+
+void ObjectRegistry::erase(ObjectHandle handle)
+{
+  assert(alive(handle) && "erasing a dead handle");
+  auto& slot     = m_slots[handle.index];
+  slot.object    = nullptr;
+  slot.next_free = m_free_head;
+  ++slot.generation;
+  m_free_head = handle.index;
+  --m_size;
+}
+
+void ObjectRegistry::rebind(ObjectHandle handle, BaseObject& object)
+{
+  assert(alive(handle) && "rebinding a dead handle");
+  m_slots[handle.index].object = &object;
+}
+
+BaseObject* ObjectRegistry::get(ObjectHandle handle) const
+{
+  return alive(handle) ? m_slots[handle.index].object : nullptr;
+}
+
+BaseObject* ObjectRegistry::from_pointer_value(std::uintptr_t value) const
+{
+  if constexpr (k_wide_pointers) {
+    return get(ObjectHandle::from_value(value));
+  } else {
+    auto const packed = static_cast<std::uint32_t>(value);
+    auto const index  = packed & k_packed_index;
+    if (index >= m_slots.size()) {
+      return nullptr;
+    }
+    auto const& slot = m_slots[index];
+    return (slot.generation & k_packed_generation)
+                   == packed >> k_packed_index_bits
+             ? slot.object
+             : nullptr;
+  }
+}
+
+bool ObjectRegistry::alive(ObjectHandle handle) const
+{
+  return handle.index < m_slots.size()
+      && m_slots[handle.index].generation == handle.generation
+      && m_slots[handle.index].object != nullptr;
+}
+
+std::size_t ObjectRegistry::size() const
+{
+  return m_size;
+}
+
+} // namespace isaac
@@ -6,6 +6,7 @@
 #include "isaac/system/input.hpp"
 #include "isaac/system/logger.hpp"
 #include "isaac/system/service_locator.hpp"
+#include "isaac/system/trace.hpp"
 
 #include <cstdlib>
 
@@ -14,19 +15,46 @@
 
 namespace isaac {
 
-Isaac::Isaac(std::string name, sf::Vector2u window_size, Logger::Level level)
-    : m_logger{ServiceLocator<Logger>::register_service(level)}
+Isaac::Isaac(std::string name, sf::Vector2u window_size, Logger::Level level,
+             std::size_t physics_workers, std::size_t job_workers)
+    : m_logger{ServiceLocator<Logger>::register_service<AsyncLogger>(level)}
     , m_window_server{ServiceLocator<WindowServer>::register_service(
           window_size, std::move(name))}
-    , m_physics_server{ServiceLocator<PhysicsServer2D>::register_service()}
+    , m_physics_server{ServiceLocator<PhysicsServer2D>::register_service(
+          physics_workers)}
     , m_scene_manager{ServiceLocator<SceneManager>::register_service()}
     , m_input{ServiceLocator<Input>::register_service()}
+    , m_event_bus{ServiceLocator<EventBus>::register_service()}
+    , m_jobs{ServiceLocator<JobSystem>::register_service(job_workers)}
+    , m_world{*m_window_server, *m_scene_manager, *m_physics_server}
+{}
+
+Isaac::Isaac(headless_t, Logger::Level level, std::size_t physics_workers,
+             std::size_t job_workers)
+    : m_logger{ServiceLocator<Logger>::register_service<AsyncLogger>(level)}
+    , m_window_server{ServiceLocator<WindowServer>::register_service(headless)}
+    , m_physics_server{ServiceLocator<PhysicsServer2D>::register_service(
+          physics_workers)}
+    , m_scene_manager{ServiceLocator<SceneManager>::register_service()}
+    , m_input{ServiceLocator<Input>::register_service()}
+    , m_event_bus{ServiceLocator<EventBus>::register_service()}
+    , m_jobs{ServiceLocator<JobSystem>::register_service(job_workers)}
     , m_world{*m_window_server, *m_scene_manager, *m_physics_server}
 {}
 
 Isaac::~Isaac()
 {
-  m_logger->info("Closing Isaac game");
+  if (Tracer::enabled()) {
+    auto& tracer = Tracer::instance();
+    tracer.stop();
+    auto const path = tracer.path().string();
+    if (tracer.flush()) {
+      ISAAC_LOG_INFO(*m_logger, "Trace written to {}", path);
+    } else {
+      ISAAC_LOG_ERROR(*m_logger, "Cannot write trace to {}", path);
+    }
+  }
+  ISAAC_LOG_INFO(*m_logger, "Closing Isaac game");
 }
 
 void Isaac::set_scene(std::unique_ptr<Scene> scene)
@@ -34,16 +62,36 @@ void Isaac::set_scene(std::unique_ptr<Scene> scene)
   m_main_scene = std::move(scene);
 }
 
-int Isaac::run()
+void Isaac::set_fixed_update_rate(float update_rate)
+{
+  m_world.set_fixed_update_rate(update_rate);
+}
+
+void Isaac::set_physics_settings(PhysicsSettings const& settings)
+{
+  m_physics_server->set_settings(settings);
+}
+
+void Isaac::set_physics_debug_draw(bool enabled)
+{
+  m_physics_server->set_debug_draw(enabled);
+}
+
+int Isaac::run(std::size_t ticks)
 {
   if (!start()) {
     return EXIT_FAILURE;
   }
   // here everything happens
-  m_world.game_loop();
+  m_world.game_loop(ticks);
   return EXIT_SUCCESS;
 }
 
+void Isaac::stop()
+{
+  m_world.stop();
+}
+
 bool Isaac::start()
 {
   if (m_main_scene == nullptr) {
@@ -53,7 +101,7 @@ bool Isaac::start()
   }
   m_scene_manager->set_scene(std::move(m_main_scene));
   m_world.start();
-  m_logger->info("Game started");
+  ISAAC_LOG_INFO(*m_logger, "Game started");
   return true;
 }
 } // namespace isaac
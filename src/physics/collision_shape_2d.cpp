@@ -5,39 +5,90 @@
 
 namespace isaac {
 
+CollisionShapeBase::CollisionShapeBase(ShapeKey const& key)
+    : m_prototype{&ShapeCache::instance().get(key)}
+{}
+
+void CollisionShapeBase::set_key(ShapeKey const& key)
+{
+  m_prototype = &ShapeCache::instance().get(key);
+}
+
+ShapePrototype const& CollisionShapeBase::prototype() const
+{
+  return *m_prototype;
+}
+
 b2ShapeDef const& CollisionShapeBase::shape_def() const
 {
-  return m_shape_def;
+  return m_prototype->def;
+}
+
+void CollisionShapeBase::set_sensor(bool sensor)
+{
+  auto key   = m_prototype->key;
+  key.sensor = sensor;
+  set_key(key);
+}
+
+void CollisionShapeBase::enable_sensor_events(bool enable)
+{
+  auto key          = m_prototype->key;
+  key.sensor_events = enable;
+  set_key(key);
+}
+
+void CollisionShapeBase::enable_hit_events(bool enable)
+{
+  auto key       = m_prototype->key;
+  key.hit_events = enable;
+  set_key(key);
 }
 
 Box2DShape::Box2DShape(sf::Vector2f size)
-    : m_polygon{b2MakeBox(size.x / 2.f, size.y / 2.f)}
-    , m_size{size.x, size.y}
+    : CollisionShapeBase{ShapeKey::of(ShapeKey::Type::box, size)}
 {}
 
-b2Vec2 const& Box2DShape::size() const
+b2Vec2 Box2DShape::size() const
 {
-  return m_size;
+  return {prototype().key.extent.x, prototype().key.extent.y};
 }
 
 b2ShapeId Box2DShape::make_shape(b2BodyId body_id)
 {
-  return b2CreatePolygonShape(body_id, &shape_def(), &m_polygon);
+  return b2CreatePolygonShape(body_id, &shape_def(), &prototype().polygon);
+}
+
+b2ShapeProxy Box2DShape::make_proxy(sf::Vector2f center,
+                                    sf::Angle rotation) const
+{
+  auto const& polygon = prototype().polygon;
+  return b2MakeOffsetProxy(polygon.vertices, polygon.count, polygon.radius,
+                           {center.x, center.y},
+                           b2MakeRot(rotation.asRadians()));
 }
 
 Circle2DShape::Circle2DShape(float radius)
-    : m_circle{0, 0, radius}
-    , m_radius{radius}
+    : CollisionShapeBase{ShapeKey::of(ShapeKey::Type::circle, {radius, 0.f})}
 {}
 
 float Circle2DShape::get_radius() const
 {
-  return m_radius;
+  return prototype().key.extent.x;
 }
 
 b2ShapeId Circle2DShape::make_shape(b2BodyId body_id)
 {
-  return b2CreateCircleShape(body_id, &shape_def(), &m_circle);
+  return b2CreateCircleShape(body_id, &shape_def(), &prototype().circle);
+}
+
+b2ShapeProxy Circle2DShape::make_proxy(sf::Vector2f center,
+                                       sf::Angle rotation) const
+{
+  auto const& circle = prototype().circle;
+  return b2MakeOffsetProxy(&circle.center, 1, circle.radius,
+                           {center.x, center.y},
+                           b2MakeRot(rotation.asRadians()));
 }
 
 } // namespace isaac
@@ -0,0 +1,230 @@
+#include "isaac/physics/debug_draw_2d.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace isaac {
+
+namespace {
+
+constexpr std::size_t k_circle_segments = 24;
+// fills are translucent so overlapping bodies stay readable
+constexpr std::uint8_t k_fill_alpha = 75;
+
+using Circle = std::array<sf::Vector2f, k_circle_segments>;
+
+Circle const& unit_circle()
+{
+  static auto const circle = [] {
+    Circle points{};
+    for (std::size_t i = 0; i < k_circle_segments; ++i) {
+      auto const angle = 2.f * std::numbers::pi_v<float>
+                       * static_cast<float>(i) / k_circle_segments;
+      points[i] = {std::cos(angle), std::sin(angle)};
+    }
+    return points;
+  }();
+  return circle;
+}
+
+sf::Color to_color(b2HexColor color, std::uint8_t alpha = 255)
+{
+  auto const hex = static_cast<std::uint32_t>(color);
+  return {static_cast<std::uint8_t>(hex >> 16),
+          static_cast<std::uint8_t>(hex >> 8), static_cast<std::uint8_t>(hex),
+          alpha};
+}
+
+sf::Vector2f to_vector(b2Vec2 v)
+{
+  return {v.x, v.y};
+}
+
+sf::Vector2f to_vector(b2Transform const& transform, b2Vec2 v)
+{
+  auto const& q = transform.q;
+  return {q.c * v.x - q.s * v.y + transform.p.x,
+          q.s * v.x + q.c * v.y + transform.p.y};
+}
+
+void add_line(std::vector<sf::Vertex>& lines, sf::Vector2f a, sf::Vector2f b,
+              sf::Color color)
+{
+  lines.push_back({a, color});
+  lines.push_back({b, color});
+}
+
+void add_circle(std::vector<sf::Vertex>& lines, sf::Vector2f center,
+                float radius, sf::Color color)
+{
+  auto const& circle = unit_circle();
+  for (std::size_t i = 0; i < k_circle_segments; ++i) {
+    add_line(lines, center + circle[i] * radius,
+             center + circle[(i + 1) % k_circle_segments] * radius, color);
+  }
+}
+
+DebugDraw2D& self(void* context)
+{
+  return *static_cast<DebugDraw2D*>(context);
+}
+
+} // namespace
+
+DebugDraw2D::DebugDraw2D()
+    : m_draw{b2DefaultDebugDraw()}
+{
+  m_draw.DrawPolygonFcn      = draw_polygon;
+  m_draw.DrawSolidPolygonFcn = draw_solid_polygon;
+  m_draw.DrawCircleFcn       = draw_circle;
+  m_draw.DrawSolidCircleFcn  = draw_solid_circle;
+  m_draw.DrawSegmentFcn      = draw_segment;
+  m_draw.DrawPointFcn        = draw_point;
+  m_draw.drawShapes          = true;
+  m_draw.useDrawingBounds    = true;
+}
+
+void DebugDraw2D::draw_polygon(b2Vec2 const* vertices, int vertex_count,
+                               b2HexColor color, void* context)
+{
+  auto& lines        = self(context).m_lines;
+  auto const outline = to_color(color);
+  for (int i = 0; i < vertex_count; ++i) {
+    add_line(lines, to_vector(vertices[i]),
+             to_vector(vertices[(i + 1) % vertex_count]), outline);
+  }
+}
+
+// rounded polygons are drawn without their radius
+void DebugDraw2D::draw_solid_polygon(b2Transform transform,
+                                     b2Vec2 const* vertices, int vertex_count,
+                                     float, b2HexColor color, void* context)
+{
+  auto& draw         = self(context);
+  auto const fill    = to_color(color, k_fill_alpha);
+  auto const outline = to_color(color);
+  auto const first   = to_vector(transform, vertices[0]);
+  auto previous      = first;
+  for (int i = 1; i < vertex_count; ++i) {
+    auto const point = to_vector(transform, vertices[i]);
+    if (i > 1) {
+      draw.m_triangles.push_back({first, fill});
+      draw.m_triangles.push_back({previous, fill});
+      draw.m_triangles.push_back({point, fill});
+    }
+    add_line(draw.m_lines, previous, point, outline);
+    previous = point;
+  }
+  add_line(draw.m_lines, previous, first, outline);
+}
+
+void DebugDraw2D::draw_circle(b2Vec2 center, float radius, b2HexColor color,
+                              void* context)
+{
+  add_circle(self(context).m_lines, to_vector(center), radius,
+             to_color(color));
+}
+
+void DebugDraw2D::draw_solid_circle(b2Transform transform, float radius,
+                                    b2HexColor color, void* context)
+{
+  auto& draw         = self(context);
+  auto const& circle = unit_circle();
+  auto const center  = to_vector(transform.p);
+  auto const fill    = to_color(color, k_fill_alpha);
+  auto const outline = to_color(color);
+  for (std::size_t i = 0; i < k_circle_segments; ++i) {
+    auto const next = (i + 1) % k_circle_segments;
+    draw.m_triangles.push_back({center, fill});
+    draw.m_triangles.push_back({center + circle[i] * radius, fill});
+    draw.m_triangles.push_back({center + circle[next] * radius, fill});
+  }
+  add_circle(draw.m_lines, center, radius, outline);
+  // the radius along the body x axis shows the rotation
+  add_line(draw.m_lines, center,
+           center + sf::Vector2f{transform.q.c, transform.q.s} * radius,
+           outline);
+}
+
+void DebugDraw2D::draw_segment(b2Vec2 a, b2Vec2 b, b2HexColor color,
+                               void* context)
+{
+  add_line(self(context).m_lines, to_vector(a), to_vector(b),
+           to_color(color));
+}
+
+void DebugDraw2D::draw_point(b2Vec2 p, float size, b2HexColor color,
+                             void* context)
+{
+  auto& triangles   = self(context).m_triangles;
+  auto const fill   = to_color(color);
+  auto const center = to_vector(p);
+  auto const half   = size / 2.f;
+  auto const a      = center + sf::Vector2f{-half, -half};
+  auto const b      = center + sf::Vector2f{half, -half};
+  auto const c      = center + sf::Vector2f{half, half};
+  auto const d      = center + sf::Vector2f{-half, half};
+  for (auto const point : {a, b, c, a, c, d}) {
+    triangles.push_back({point, fill});
+  }
+}
+
+void DebugDraw2D::set_draw_shapes(bool draw)
+{
+  m_draw.drawShapes = draw;
+}
+
+void DebugDraw2D::set_draw_bounds(bool draw)
+{
+  m_draw.drawBounds = draw;
+}
+
+void DebugDraw2D::collect(b2WorldId world, sf::View const& view)
+{
+  // the view maps the world onto [-1, 1], a rotated view is culled to the
+  // box around it
+  auto const bounds =
+      view.getInverseTransform().transformRect({{-1.f, -1.f}, {2.f, 2.f}});
+  m_draw.drawingBounds = {{bounds.position.x, bounds.position.y},
+                          {bounds.position.x + bounds.size.x,
+                           bounds.position.y + bounds.size.y}};
+  m_draw.context = this;
+  b2World_Draw(world, &m_draw);
+}
+
+void DebugDraw2D::draw(sf::RenderTarget& target)
+{
+  if (!m_triangles.empty()) {
+    target.draw(m_triangles.data(), m_triangles.size(),
+                sf::PrimitiveType::Triangles);
+  }
+  if (!m_lines.empty()) {
+    target.draw(m_lines.data(), m_lines.size(), sf::PrimitiveType::Lines);
+  }
+  clear();
+}
+
+void DebugDraw2D::clear()
+{
+  m_triangles.clear();
+  m_lines.clear();
+}
+
+void DebugDraw2D::release()
+{
+  m_triangles = {};
+  m_lines     = {};
+}
+
+std::size_t DebugDraw2D::vertex_count() const
+{
+  return m_triangles.size() + m_lines.size();
+}
+
+} // namespace isaac
@@ -1,111 +1,462 @@
 #include "isaac/physics/physics_2d.hpp"
-#include "isaac/render/window_server.hpp"
+#include "isaac/components/game_object.hpp"
 #include "isaac/system/logger.hpp"
+#include "isaac/system/profiler.hpp"
 #include "isaac/system/service_locator.hpp"
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/ConvexShape.hpp>
+#include "isaac/system/trace.hpp"
 #include <box2d/box2d.h>
 #include <box2d/id.h>
 #include <box2d/types.h>
 
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
 namespace isaac {
 
 namespace {
 
-void DrawPointFcn(b2Vec2 p, float size, b2HexColor color, void* context)
+// queries handed to a job at once, each one is a few tree traversals
+constexpr int k_queries_per_job = 64;
+
+sf::Vector2f to_vector(b2Vec2 v)
+{
+  return {v.x, v.y};
+}
+
+b2Vec2 to_b2(sf::Vector2f v)
+{
+  return {v.x, v.y};
+}
+
+b2AABB to_aabb(sf::FloatRect const& rect)
 {
-  auto& window = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::CircleShape point{size, 4};
-  point.setPosition({p.x, p.y});
-  window.draw(sf::CircleShape{1.f});
+  return {to_b2(rect.position), to_b2(rect.position + rect.size)};
 }
 
-void DrawPolygonFcn(b2Vec2 const* vertices, int vertex_count, b2HexColor color,
-                    void* context)
+CollisionBody2D* body_of(b2ShapeId shape_id)
 {
-  auto& window = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::ConvexShape shape{static_cast<size_t>(vertex_count)};
-  for (size_t i = 0; i < vertex_count; ++i) {
-    shape.setPoint(i, {vertices[i].x, vertices[i].y});
+  auto const body_id = b2Shape_GetBody(shape_id);
+  return CollisionBody2D::from_user_data(b2Body_GetUserData(body_id));
+}
+
+CastHit2D to_hit(b2RayResult const& result)
+{
+  if (!result.hit) {
+    return {};
   }
-  shape.setFillColor(sf::Color::Transparent);
-  shape.setOutlineColor(sf::Color{147, 115, 165});
-  shape.setOutlineThickness(1.0f);
-  window.draw(shape);
+  return {true, body_of(result.shapeId), result.shapeId,
+          to_vector(result.point), to_vector(result.normal), result.fraction};
 }
 
-void DrawSolidPolygonFcn(b2Transform transform, b2Vec2 const* vertices,
-                         int vertex_count, float, b2HexColor, void*)
+// clipping the cast to every hit leaves the closest one
+float closest_hit(b2ShapeId shape, b2Vec2 point, b2Vec2 normal, float fraction,
+                  void* context)
 {
-  auto& window = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::ConvexShape shape{static_cast<size_t>(vertex_count)};
-  for (size_t i = 0; i < vertex_count; ++i) {
-    shape.setPoint(i, {vertices[i].x, vertices[i].y});
+  *static_cast<b2RayResult*>(context) = {shape, point, normal, fraction,
+                                         0,     0,     true};
+  return fraction;
+}
+
+bool append_body(b2ShapeId shape, void* context)
+{
+  if (auto const body = body_of(shape)) {
+    static_cast<std::vector<CollisionBody2D*>*>(context)->push_back(body);
   }
-  shape.setPosition({transform.p.x, transform.p.y});
-  shape.setFillColor(sf::Color{147, 115, 165, 75});
-  window.draw(shape);
+  return true;
 }
 
-void DrawCircleFcn(b2Vec2 center, float radius, b2HexColor color, void* context)
+// the slots of one query in OverlapResults2D
+struct OverlapSlots
+{
+  CollisionBody2D** bodies;
+  std::size_t capacity;
+  std::size_t found;
+};
+
+bool fill_slot(b2ShapeId shape, void* context)
 {
-  auto& window = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::CircleShape circle{radius};
-  circle.setPosition({center.x, center.y});
-  window.draw(circle);
+  auto& slots = *static_cast<OverlapSlots*>(context);
+  if (auto const body = body_of(shape)) {
+    if (slots.found < slots.capacity) {
+      slots.bodies[slots.found] = body;
+    }
+    ++slots.found;
+  }
+  return true;
 }
 
-void DrawSolidCircleFcn(b2Transform transform, float radius, b2HexColor color,
-                        void* context)
+// fn(begin, end) over the queries, on the job workers when given some
+template<typename F>
+void for_each_query(std::size_t count, JobSystem* jobs, F const& fn)
 {
-  auto& window = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::CircleShape circle{radius};
-  circle.setPosition({transform.p.x - radius, transform.p.y - radius});
-  window.draw(circle);
+  auto const queries = static_cast<int>(count);
+  if (jobs != nullptr && jobs->size() > 1 && queries > k_queries_per_job) {
+    jobs->parallel_for(queries, k_queries_per_job, fn);
+  } else {
+    fn(0, queries);
+  }
 }
 
-void DrawSegmentFcn(b2Vec2 a, b2Vec2 b, b2HexColor color, void* context)
+void check_results(std::size_t queries, std::size_t results)
 {
-  auto& window      = ServiceLocator<WindowServer>::get_service()->get_window();
-  sf::Vertex line[] = {sf::Vertex{{a.x, a.y}}, sf::Vertex{{b.x, b.y}}};
-  window.draw(line, 2, sf::PrimitiveType::Lines);
+  if (results < queries) {
+    throw std::runtime_error(
+        std::format("{} queries for {} results", queries, results));
+  }
 }
 
 } // namespace
 
-DebugDrawer::DebugDrawer()
-    : drawer{b2DefaultDebugDraw()}
-{}
+namespace detail {
 
-PhysicsServer2D::PhysicsServer2D()
-    : m_logger(*ServiceLocator<Logger>::get_service())
-    , m_debug_drawer{b2DefaultDebugDraw()}
-{
-  m_debug_drawer.DrawPointFcn        = DrawPointFcn;
-  m_debug_drawer.DrawPolygonFcn      = DrawPolygonFcn;
-  m_debug_drawer.DrawSolidPolygonFcn = DrawSolidPolygonFcn;
-  m_debug_drawer.DrawCircleFcn       = DrawCircleFcn;
-  m_debug_drawer.DrawSolidCircleFcn  = DrawSolidCircleFcn;
-  m_debug_drawer.DrawSegmentFcn      = DrawSegmentFcn;
-  m_debug_drawer.drawShapes          = true;
-  m_debug_drawer.drawBounds          = true;
-  m_debug_drawer.context             = this;
+b2WorldDef const& default_world_def()
+{
+  static auto const def = b2DefaultWorldDef();
+  return def;
+}
 
+b2BodyDef const& default_body_def()
+{
+  static auto const def = b2DefaultBodyDef();
+  return def;
+}
+
+} // namespace detail
+
+PhysicsServer2D::PhysicsServer2D(std::size_t worker_count,
+                                 PhysicsSettings const& settings)
+    : m_logger(*ServiceLocator<Logger>::get_service())
+    , m_worker_pool{worker_count}
+{
   auto world_def    = b2DefaultWorldDef();
   world_def.gravity = {0, k_gravity};
-  m_world_id        = b2CreateWorld(&world_def);
-  m_logger.debug("PhysicsServer2D initialized");
+  if (m_worker_pool.size() > 1) {
+    world_def.workerCount     = static_cast<int>(m_worker_pool.size());
+    world_def.enqueueTask     = enqueue_task;
+    world_def.finishTask      = finish_task;
+    world_def.userTaskContext = this;
+  }
+  m_world_id = b2CreateWorld(&world_def);
+  set_settings(settings);
+  ISAAC_LOG_DEBUG(m_logger, "PhysicsServer2D initialized with {} workers",
+                  m_worker_pool.size());
 }
 
 PhysicsServer2D::~PhysicsServer2D()
 {
   b2DestroyWorld(m_world_id);
-  m_logger.debug("PhysicServer2D shutdown");
+  ISAAC_LOG_DEBUG(m_logger, "PhysicServer2D shutdown");
 }
 
 void PhysicsServer2D::update(float delta)
 {
-  b2World_Step(m_world_id, delta, 4);
-  b2World_Draw(m_world_id, &m_debug_drawer);
+  ISAAC_PROFILE_ZONE("PhysicsServer2D::update");
+  {
+    ISAAC_PROFILE_ZONE("b2World_Step");
+    b2World_Step(m_world_id, delta, m_sub_steps);
+  }
+  ISAAC_PROFILE_COUNTER("physics sub-steps", m_sub_steps);
+  if (m_settings.adaptive_sub_steps) {
+    // Box2D times its steps already, in milliseconds
+    adapt_sub_steps(b2World_GetProfile(m_world_id).step / 1000.f);
+  }
+  m_task_count = 0;
+  sync_bodies();
+  dispatch_collisions();
+}
+
+void PhysicsServer2D::set_settings(PhysicsSettings const& settings)
+{
+  m_settings               = settings;
+  m_settings.sub_steps     = std::max(m_settings.sub_steps, 1);
+  m_settings.min_sub_steps =
+      std::clamp(m_settings.min_sub_steps, 1, m_settings.sub_steps);
+  m_sub_steps  = m_settings.sub_steps;
+  m_fast_steps = 0;
+
+  b2World_SetContactTuning(m_world_id, m_settings.contact_hertz,
+                           m_settings.contact_damping_ratio,
+                           m_settings.contact_push_speed);
+  b2World_SetMaximumLinearSpeed(m_world_id, m_settings.maximum_linear_speed);
+  b2World_EnableSleeping(m_world_id, m_settings.enable_sleep);
+  b2World_EnableContinuous(m_world_id, m_settings.enable_continuous);
+  b2World_SetRestitutionThreshold(m_world_id,
+                                  m_settings.restitution_threshold);
+  b2World_SetHitEventThreshold(m_world_id, m_settings.hit_event_threshold);
+
+  prune_default_sleep_bodies();
+  for (auto const body : m_default_sleep_bodies) {
+    b2Body_SetSleepThreshold(body, m_settings.sleep_threshold);
+  }
+}
+
+b2BodyId PhysicsServer2D::create_body(b2BodyDef def)
+{
+  auto const follows_settings =
+      def.sleepThreshold == detail::default_body_def().sleepThreshold;
+  if (follows_settings) {
+    def.sleepThreshold = m_settings.sleep_threshold;
+  }
+  auto const body = b2CreateBody(m_world_id, &def);
+  if (follows_settings) {
+    if (m_default_sleep_bodies.size() >= m_prune_at) {
+      prune_default_sleep_bodies();
+      m_prune_at = std::max<std::size_t>(m_default_sleep_bodies.size() * 2,
+                                         m_prune_at);
+    }
+    m_default_sleep_bodies.push_back(body);
+  }
+  return body;
+}
+
+void PhysicsServer2D::prune_default_sleep_bodies()
+{
+  std::erase_if(m_default_sleep_bodies,
+                [](b2BodyId body) { return !b2Body_IsValid(body); });
+}
+
+PhysicsSettings const& PhysicsServer2D::settings() const
+{
+  return m_settings;
+}
+
+int PhysicsServer2D::sub_steps() const
+{
+  return m_sub_steps;
+}
+
+// gives up accuracy at once when a step overruns its budget, and takes it
+// back only after a run of cheap steps so the count does not oscillate
+void PhysicsServer2D::adapt_sub_steps(float step_time)
+{
+  auto const budget = m_settings.step_budget;
+  if (step_time > budget && m_sub_steps > m_settings.min_sub_steps) {
+    --m_sub_steps;
+    m_fast_steps = 0;
+  } else if (step_time < budget / 2 && m_sub_steps < m_settings.sub_steps) {
+    if (++m_fast_steps >= k_adaptive_steps) {
+      ++m_sub_steps;
+      m_fast_steps = 0;
+    }
+  } else {
+    m_fast_steps = 0;
+  }
+}
+
+void PhysicsServer2D::sync_bodies()
+{
+  // only bodies that moved during the step are reported, sleeping ones are
+  // left untouched
+  ISAAC_PROFILE_ZONE("PhysicsServer2D::sync_bodies");
+  auto const events = b2World_GetBodyEvents(m_world_id);
+  ISAAC_PROFILE_COUNTER("bodies moved", events.moveCount);
+  for (int i = 0; i < events.moveCount; ++i) {
+    auto const& event = events.moveEvents[i];
+    if (auto body = CollisionBody2D::from_user_data(event.userData)) {
+      body->sync_transform(event.transform);
+    }
+  }
+}
+
+void PhysicsServer2D::dispatch_collisions()
+{
+  // Box2D keeps the events of the last step in its own buffers, they are
+  // walked in place and every Collision2D lives on the stack
+  ISAAC_PROFILE_ZONE("PhysicsServer2D::dispatch_collisions");
+  using enum Collision2D::Type;
+  auto const contacts = b2World_GetContactEvents(m_world_id);
+  for (int i = 0; i < contacts.beginCount; ++i) {
+    auto const& event = contacts.beginEvents[i];
+    Collision2D collision{begin};
+    collision.normal = to_vector(event.manifold.normal);
+    if (event.manifold.pointCount > 0) {
+      collision.point = to_vector(event.manifold.points[0].point);
+    }
+    dispatch(event.shapeIdA, event.shapeIdB, collision);
+  }
+  for (int i = 0; i < contacts.endCount; ++i) {
+    auto const& event = contacts.endEvents[i];
+    dispatch(event.shapeIdA, event.shapeIdB, Collision2D{end});
+  }
+  for (int i = 0; i < contacts.hitCount; ++i) {
+    auto const& event = contacts.hitEvents[i];
+    Collision2D collision{hit};
+    collision.point          = to_vector(event.point);
+    collision.normal         = to_vector(event.normal);
+    collision.approach_speed = event.approachSpeed;
+    dispatch(event.shapeIdA, event.shapeIdB, collision);
+  }
+
+  auto const sensors = b2World_GetSensorEvents(m_world_id);
+  for (int i = 0; i < sensors.beginCount; ++i) {
+    auto const& event = sensors.beginEvents[i];
+    dispatch(event.sensorShapeId, event.visitorShapeId,
+             Collision2D{sensor_begin});
+  }
+  for (int i = 0; i < sensors.endCount; ++i) {
+    auto const& event = sensors.endEvents[i];
+    dispatch(event.sensorShapeId, event.visitorShapeId,
+             Collision2D{sensor_end});
+  }
+}
+
+void PhysicsServer2D::dispatch(b2ShapeId shape_a, b2ShapeId shape_b,
+                               Collision2D collision)
+{
+  // end events can refer to shapes destroyed since the contact began
+  if (!b2Shape_IsValid(shape_a) || !b2Shape_IsValid(shape_b)) {
+    return;
+  }
+  auto const body_a = body_of(shape_a);
+  auto const body_b = body_of(shape_b);
+  if (body_a == nullptr || body_b == nullptr) {
+    return;
+  }
+
+  collision.collider = body_a;
+  collision.other    = body_b;
+  if (auto go = body_a->game_object()) {
+    go->on_collision_2d(collision);
+  }
+
+  collision.collider = body_b;
+  collision.other    = body_a;
+  collision.normal   = -collision.normal;
+  if (auto go = body_b->game_object()) {
+    go->on_collision_2d(collision);
+  }
+}
+
+void* PhysicsServer2D::enqueue_task(b2TaskCallback* task, int item_count,
+                                    int min_range, void* task_context,
+                                    void* user_context)
+{
+  auto& server = *static_cast<PhysicsServer2D*>(user_context);
+  if (server.m_task_count == k_max_tasks) {
+    // out of task slots, Box2D treats a null handle as already executed
+    task(0, item_count, 0, task_context);
+    return nullptr;
+  }
+  // a few blocks per worker keeps the load balanced without tiny ranges
+  auto const workers = static_cast<int>(server.m_worker_pool.size());
+  auto const block   = std::max(min_range, item_count / (4 * workers));
+  auto& job          = server.m_tasks[server.m_task_count++];
+  job.reset(task, task_context, item_count, block);
+  server.m_worker_pool.submit(job);
+  return &job;
+}
+
+void PhysicsServer2D::finish_task(void* user_task, void* user_context)
+{
+  if (user_task == nullptr) {
+    return;
+  }
+  auto& server = *static_cast<PhysicsServer2D*>(user_context);
+  server.m_worker_pool.wait(*static_cast<ParallelJob*>(user_task));
+}
+
+void PhysicsServer2D::set_debug_draw(bool enabled)
+{
+  m_debug_draw_enabled = enabled;
+  if (!enabled) {
+    // releases the vertices of a large scene, keeping the options
+    m_debug_draw.release();
+  }
+}
+
+DebugDraw2D& PhysicsServer2D::debug_drawer()
+{
+  return m_debug_draw;
+}
+
+bool PhysicsServer2D::debug_draw_enabled() const
+{
+  return m_debug_draw_enabled;
+}
+
+void PhysicsServer2D::debug_draw(sf::RenderTarget& target)
+{
+  if (!m_debug_draw_enabled) {
+    return;
+  }
+  ISAAC_PROFILE_ZONE("PhysicsServer2D::debug_draw");
+  debug_draw(m_debug_draw, target.getView());
+  ISAAC_PROFILE_COUNTER("debug draw vertices", m_debug_draw.vertex_count());
+  m_debug_draw.draw(target);
+}
+
+void PhysicsServer2D::debug_draw(DebugDraw2D& batch,
+                                 sf::View const& view) const
+{
+  batch.collect(m_world_id, view);
+}
+
+CastHit2D PhysicsServer2D::raycast(Ray2D const& ray, b2QueryFilter filter) const
+{
+  return to_hit(b2World_CastRayClosest(m_world_id, to_b2(ray.origin),
+                                       to_b2(ray.translation), filter));
+}
+
+CastHit2D PhysicsServer2D::shape_cast(ShapeCast2D const& cast,
+                                      b2QueryFilter filter) const
+{
+  b2RayResult result{};
+  b2World_CastShape(m_world_id, &cast.shape, to_b2(cast.translation), filter,
+                    closest_hit, &result);
+  return to_hit(result);
+}
+
+std::size_t PhysicsServer2D::overlap(sf::FloatRect const& area,
+                                     std::vector<CollisionBody2D*>& bodies,
+                                     b2QueryFilter filter) const
+{
+  auto const size = bodies.size();
+  b2World_OverlapAABB(m_world_id, to_aabb(area), filter, append_body, &bodies);
+  return bodies.size() - size;
+}
+
+void PhysicsServer2D::raycast(std::span<Ray2D const> rays,
+                              std::span<CastHit2D> hits, b2QueryFilter filter,
+                              JobSystem* jobs) const
+{
+  ISAAC_TRACE_ZONE("PhysicsServer2D::raycast");
+  check_results(rays.size(), hits.size());
+  for_each_query(rays.size(), jobs, [&](int begin, int end) {
+    for (auto i = begin; i < end; ++i) {
+      hits[i] = raycast(rays[i], filter);
+    }
+  });
+}
+
+void PhysicsServer2D::shape_cast(std::span<ShapeCast2D const> casts,
+                                 std::span<CastHit2D> hits,
+                                 b2QueryFilter filter, JobSystem* jobs) const
+{
+  ISAAC_TRACE_ZONE("PhysicsServer2D::shape_cast");
+  check_results(casts.size(), hits.size());
+  for_each_query(casts.size(), jobs, [&](int begin, int end) {
+    for (auto i = begin; i < end; ++i) {
+      hits[i] = shape_cast(casts[i], filter);
+    }
+  });
+}
+
+void PhysicsServer2D::overlap(std::span<sf::FloatRect const> areas,
+                              OverlapResults2D& results, b2QueryFilter filter,
+                              JobSystem* jobs) const
+{
+  ISAAC_TRACE_ZONE("PhysicsServer2D::overlap");
+  results.resize(areas.size());
+  for_each_query(areas.size(), jobs, [&](int begin, int end) {
+    for (auto i = begin; i < end; ++i) {
+      auto const offset = static_cast<std::size_t>(i) * results.m_max_per_query;
+      OverlapSlots slots{results.m_bodies.data() + offset,
+                         results.m_max_per_query, 0};
+      b2World_OverlapAABB(m_world_id, to_aabb(areas[i]), filter, fill_slot,
+                          &slots);
+      results.m_found[i] = slots.found;
+    }
+  });
 }
 } // namespace isaac
@@ -0,0 +1,34 @@
+#include "isaac/physics/query_2d.hpp"
+
+#include <algorithm>
+
+namespace isaac {
+
+OverlapResults2D::OverlapResults2D(std::size_t max_per_query)
+    : m_max_per_query{std::max<std::size_t>(max_per_query, 1)}
+{}
+
+void OverlapResults2D::resize(std::size_t query_count)
+{
+  m_bodies.resize(query_count * m_max_per_query);
+  m_found.assign(query_count, 0);
+}
+
+std::size_t OverlapResults2D::size() const
+{
+  return m_found.size();
+}
+
+std::span<CollisionBody2D* const> OverlapResults2D::operator[](
+    std::size_t query) const
+{
+  return {m_bodies.data() + query * m_max_per_query,
+          std::min(m_found[query], m_max_per_query)};
+}
+
+bool OverlapResults2D::truncated(std::size_t query) const
+{
+  return m_found[query] > m_max_per_query;
+}
+
+} // namespace isaac
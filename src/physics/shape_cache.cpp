@@ -0,0 +1,71 @@
+#include "isaac/physics/shape_cache.hpp"
+
+#include <box2d/box2d.h>
+
+#include <bit>
+#include <functional>
+
+namespace isaac {
+
+ShapeKey ShapeKey::of(Type type, sf::Vector2f extent)
+{
+  static auto const def = b2DefaultShapeDef();
+  return {type, extent, def.isSensor, def.enableSensorEvents,
+          def.enableHitEvents};
+}
+
+namespace {
+
+// -0 compares equal to 0, so it must hash the same
+std::uint32_t bits_of(float value)
+{
+  return std::bit_cast<std::uint32_t>(value == 0.f ? 0.f : value);
+}
+
+} // namespace
+
+std::size_t ShapeKeyHash::operator()(ShapeKey const& key) const
+{
+  auto const x     = bits_of(key.extent.x);
+  auto const y     = bits_of(key.extent.y);
+  auto const flags = static_cast<std::uint64_t>(key.type) << 3
+                   | static_cast<std::uint64_t>(key.sensor) << 2
+                   | static_cast<std::uint64_t>(key.sensor_events) << 1
+                   | static_cast<std::uint64_t>(key.hit_events);
+  auto const bits = (static_cast<std::uint64_t>(x) << 32 | y) ^ flags;
+  return std::hash<std::uint64_t>{}(bits * 0x9e3779b97f4a7c15ull);
+}
+
+ShapeCache& ShapeCache::instance()
+{
+  static ShapeCache cache;
+  return cache;
+}
+
+ShapePrototype const& ShapeCache::get(ShapeKey const& key)
+{
+  std::lock_guard lock{m_mutex};
+  auto const [it, inserted] = m_prototypes.try_emplace(key);
+  auto& prototype           = it->second;
+  if (inserted) {
+    prototype.key                    = key;
+    prototype.def                    = b2DefaultShapeDef();
+    prototype.def.isSensor           = key.sensor;
+    prototype.def.enableSensorEvents = key.sensor_events;
+    prototype.def.enableHitEvents    = key.hit_events;
+    if (key.type == ShapeKey::Type::box) {
+      prototype.polygon = b2MakeBox(key.extent.x / 2.f, key.extent.y / 2.f);
+    } else {
+      prototype.circle = {{0.f, 0.f}, key.extent.x};
+    }
+  }
+  return prototype;
+}
+
+std::size_t ShapeCache::size() const
+{
+  std::lock_guard lock{m_mutex};
+  return m_prototypes.size();
+}
+
+} // namespace isaac
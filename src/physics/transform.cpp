@@ -1 +1,143 @@
 #include "isaac/physics/transform.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define ISAAC_TRANSFORM_SSE
+#endif
+
+namespace isaac {
+
+Matrix2D Matrix2D::from(sf::Vector2f position, sf::Angle rotation,
+                        sf::Vector2f scale)
+{
+  auto const radians = rotation.asRadians();
+  auto const cos     = std::cos(radians);
+  auto const sin     = std::sin(radians);
+  return {cos * scale.x,
+          sin * scale.x,
+          -sin * scale.y,
+          cos * scale.y,
+          position.x,
+          position.y};
+}
+
+Matrix2D Matrix2D::inverse() const
+{
+  auto const det = a * d - b * c;
+  if (det == 0.f) {
+    return {};
+  }
+  auto const inv = 1.f / det;
+  return {d * inv,
+          -b * inv,
+          -c * inv,
+          a * inv,
+          (c * ty - d * tx) * inv,
+          (b * tx - a * ty) * inv};
+}
+
+sf::Angle Matrix2D::rotation() const
+{
+  return sf::radians(std::atan2(b, a));
+}
+
+sf::Vector2f Matrix2D::scale() const
+{
+  // a negative determinant is a mirror, reported on the y axis
+  auto const sign = a * d - b * c < 0.f ? -1.f : 1.f;
+  return {std::hypot(a, b), sign * std::hypot(c, d)};
+}
+
+sf::Transform Matrix2D::sf_transform() const
+{
+  return {a, c, tx, b, d, ty, 0.f, 0.f, 1.f};
+}
+
+void MatrixArray::resize(std::size_t size)
+{
+  for (auto* component : {&a, &b, &c, &d, &tx, &ty}) {
+    component->resize(size);
+  }
+}
+
+std::size_t MatrixArray::size() const
+{
+  return a.size();
+}
+
+void MatrixArray::set(std::size_t i, Matrix2D const& matrix)
+{
+  a[i]  = matrix.a;
+  b[i]  = matrix.b;
+  c[i]  = matrix.c;
+  d[i]  = matrix.d;
+  tx[i] = matrix.tx;
+  ty[i] = matrix.ty;
+}
+
+Matrix2D MatrixArray::get(std::size_t i) const
+{
+  return {a[i], b[i], c[i], d[i], tx[i], ty[i]};
+}
+
+void compose(MatrixArray const& parents, MatrixArray const& locals,
+             MatrixArray& out)
+{
+  assert(parents.size() == locals.size());
+  auto const size = parents.size();
+  out.resize(size);
+  std::size_t i = 0;
+
+#ifdef ISAAC_TRANSFORM_SSE
+  // raw pointers, the vector stores below may alias anything and would
+  // otherwise reload every vector's data pointer
+  auto const pa  = parents.a.data();
+  auto const pb  = parents.b.data();
+  auto const pc  = parents.c.data();
+  auto const pd  = parents.d.data();
+  auto const ptx = parents.tx.data();
+  auto const pty = parents.ty.data();
+  auto const la  = locals.a.data();
+  auto const lb  = locals.b.data();
+  auto const lc  = locals.c.data();
+  auto const ld  = locals.d.data();
+  auto const ltx = locals.tx.data();
+  auto const lty = locals.ty.data();
+  auto const oa  = out.a.data();
+  auto const ob  = out.b.data();
+  auto const oc  = out.c.data();
+  auto const od  = out.d.data();
+  auto const otx = out.tx.data();
+  auto const oty = out.ty.data();
+  auto const dot = [](__m128 x0, __m128 y0, __m128 x1, __m128 y1) {
+    return _mm_add_ps(_mm_mul_ps(x0, y0), _mm_mul_ps(x1, y1));
+  };
+  for (; i + 4 <= size; i += 4) {
+    auto const a  = _mm_loadu_ps(pa + i);
+    auto const b  = _mm_loadu_ps(pb + i);
+    auto const c  = _mm_loadu_ps(pc + i);
+    auto const d  = _mm_loadu_ps(pd + i);
+    auto const x  = _mm_loadu_ps(ltx + i);
+    auto const y  = _mm_loadu_ps(lty + i);
+    auto const a1 = _mm_loadu_ps(la + i);
+    auto const b1 = _mm_loadu_ps(lb + i);
+    auto const c1 = _mm_loadu_ps(lc + i);
+    auto const d1 = _mm_loadu_ps(ld + i);
+    _mm_storeu_ps(oa + i, dot(a, a1, c, b1));
+    _mm_storeu_ps(ob + i, dot(b, a1, d, b1));
+    _mm_storeu_ps(oc + i, dot(a, c1, c, d1));
+    _mm_storeu_ps(od + i, dot(b, c1, d, d1));
+    _mm_storeu_ps(otx + i, _mm_add_ps(dot(a, x, c, y), _mm_loadu_ps(ptx + i)));
+    _mm_storeu_ps(oty + i, _mm_add_ps(dot(b, x, d, y), _mm_loadu_ps(pty + i)));
+  }
+#endif
+
+  for (; i < size; ++i) {
+    out.set(i, parents.get(i) * locals.get(i));
+  }
+}
+
+} // namespace isaac
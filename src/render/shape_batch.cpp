@@ -0,0 +1,127 @@
+#include "isaac/render/shape_batch.hpp"
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+
+#include <cmath>
+
+namespace isaac {
+
+namespace {
+
+float dot(sf::Vector2f a, sf::Vector2f b)
+{
+  return a.x * b.x + a.y * b.y;
+}
+
+sf::Vector2f normal(sf::Vector2f a, sf::Vector2f b)
+{
+  sf::Vector2f n{a.y - b.y, b.x - a.x};
+  auto const length = std::sqrt(dot(n, n));
+  return length != 0.f ? n / length : n;
+}
+
+} // namespace
+
+void ShapeBatch::append(std::span<sf::Vertex const> triangles,
+                        sf::Vector2f offset)
+{
+  for (auto vertex : triangles) {
+    vertex.position += offset;
+    m_vertices.push_back(vertex);
+  }
+}
+
+void ShapeBatch::append(std::span<sf::Vertex const> triangles,
+                        Matrix2D const& transform)
+{
+  for (auto vertex : triangles) {
+    vertex.position = transform.transform_point(vertex.position);
+    m_vertices.push_back(vertex);
+  }
+}
+
+void ShapeBatch::draw(sf::RenderTarget& target)
+{
+  if (!m_vertices.empty()) {
+    target.draw(m_vertices.data(), m_vertices.size(),
+                sf::PrimitiveType::Triangles);
+  }
+  clear();
+}
+
+void ShapeBatch::clear()
+{
+  m_vertices.clear();
+}
+
+std::size_t ShapeBatch::vertex_count() const
+{
+  return m_vertices.size();
+}
+
+void ShapeBatch::tessellate(sf::Shape const& shape,
+                            std::vector<sf::Vertex>& triangles)
+{
+  auto const count = shape.getPointCount();
+  if (count < 3) {
+    return;
+  }
+
+  // points relative to the shape position, same transform sf::Shape applies
+  auto const& transform = shape.getTransform();
+  auto const position   = shape.getPosition();
+  auto const point      = [&](std::size_t i) {
+    return transform.transformPoint(shape.getPoint(i % count)) - position;
+  };
+
+  sf::Vector2f center{};
+  for (std::size_t i = 0; i < count; ++i) {
+    center += point(i);
+  }
+  center = center / static_cast<float>(count);
+
+  auto const fill = shape.getFillColor();
+  for (std::size_t i = 0; i < count; ++i) {
+    triangles.push_back({center, fill});
+    triangles.push_back({point(i), fill});
+    triangles.push_back({point(i + 1), fill});
+  }
+
+  auto const thickness = shape.getOutlineThickness();
+  if (thickness == 0.f) {
+    return;
+  }
+
+  // extrude every point along the average normal of its two edges, as
+  // sf::Shape does for its outline
+  auto const outline = shape.getOutlineColor();
+  auto const extrude = [&](std::size_t i) {
+    auto const p0 = point(i + count - 1);
+    auto const p1 = point(i);
+    auto const p2 = point(i + 1);
+    auto n1       = normal(p0, p1);
+    auto n2       = normal(p1, p2);
+    if (dot(n1, center - p1) > 0) {
+      n1 = -n1;
+    }
+    if (dot(n2, center - p1) > 0) {
+      n2 = -n2;
+    }
+    auto const factor = 1.f + dot(n1, n2);
+    return p1 + (n1 + n2) / factor * thickness;
+  };
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const inner0 = point(i);
+    auto const inner1 = point(i + 1);
+    auto const outer0 = extrude(i);
+    auto const outer1 = extrude(i + 1);
+    triangles.push_back({inner0, outline});
+    triangles.push_back({outer0, outline});
+    triangles.push_back({inner1, outline});
+    triangles.push_back({inner1, outline});
+    triangles.push_back({outer0, outline});
+    triangles.push_back({outer1, outline});
+  }
+}
+
+} // namespace isaac
@@ -19,14 +19,23 @@ WindowServer::WindowServer(sf::Vector2u const& window_size,
     std::exit(EXIT_FAILURE);
   }
   auto logger = ServiceLocator<Logger>::get_service();
-  logger->debug("WindowServer initialized");
+  ISAAC_LOG_DEBUG(*logger, "WindowServer initialized");
+}
+
+WindowServer::WindowServer(headless_t)
+    : m_headless{true}
+{
+  auto logger = ServiceLocator<Logger>::get_service();
+  ISAAC_LOG_DEBUG(*logger, "WindowServer initialized in headless mode");
 }
 
 WindowServer::~WindowServer()
 {
-  ImGui::SFML::Shutdown();
+  if (!m_headless) {
+    ImGui::SFML::Shutdown();
+  }
   auto const logger = ServiceLocator<Logger>::get_service();
-  logger->debug("Shutdown WindowServer");
+  ISAAC_LOG_DEBUG(*logger, "Shutdown WindowServer");
 }
 
 sf::RenderWindow& WindowServer::get_window()
@@ -34,4 +43,9 @@ sf::RenderWindow& WindowServer::get_window()
   return m_window;
 }
 
+bool WindowServer::headless() const
+{
+  return m_headless;
+}
+
 } // namespace isaac
@@ -0,0 +1,372 @@
+#include "isaac/system/binary_logger.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace isaac {
+
+namespace {
+
+constexpr std::size_t k_record_header  = 8;
+constexpr std::size_t k_message_header = k_record_header + 8 + 4;
+
+std::size_t padded(std::size_t size)
+{
+  return (size + 7) & ~std::size_t{7};
+}
+
+template<typename T>
+std::byte* put(std::byte* out, T const& value)
+{
+  std::memcpy(out, &value, sizeof(T));
+  return out + sizeof(T);
+}
+
+template<typename T>
+T get(char const* in)
+{
+  T value;
+  std::memcpy(&value, in, sizeof(T));
+  return value;
+}
+
+std::string_view text_of(LogArg const& arg)
+{
+  if (auto const view = std::get_if<std::string_view>(&arg)) {
+    return *view;
+  }
+  return std::get<std::string>(arg);
+}
+
+bool is_text(LogArg const& arg)
+{
+  return std::holds_alternative<std::string_view>(arg)
+      || std::holds_alternative<std::string>(arg);
+}
+
+// the size field is written last, a record is complete once it is non zero
+void publish(std::byte* record, std::size_t size)
+{
+  auto& field = *reinterpret_cast<std::uint32_t*>(record);
+  std::atomic_ref{field}.store(static_cast<std::uint32_t>(size),
+                               std::memory_order_release);
+}
+
+std::atomic<std::uint64_t> s_instances{0};
+
+} // namespace
+
+BinaryLogger::BinaryLogger(std::filesystem::path const& path, Level log_level,
+                           std::size_t capacity)
+    : Logger{log_level}
+    , m_capacity{padded(capacity)}
+    , m_offset{k_header_size}
+    , m_instance{++s_instances}
+{
+  m_structured = true;
+
+  auto const fail = [&](char const* what) {
+    if (m_fd != -1) {
+      ::close(m_fd);
+    }
+    throw std::runtime_error(
+        std::format("cannot {} binary log {}", what, path.string()));
+  };
+
+  m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  struct stat info{};
+  if (m_fd == -1 || ::fstat(m_fd, &info) == -1) {
+    fail("open");
+  }
+
+  // an existing log is appended to, anything else is overwritten
+  std::size_t existing = 0;
+  char magic[sizeof(k_magic)]{};
+  if (static_cast<std::size_t>(info.st_size) >= k_header_size
+      && ::pread(m_fd, magic, sizeof(magic), 0) == sizeof(magic)
+      && std::equal(magic, magic + sizeof(magic), k_magic)) {
+    existing = padded(static_cast<std::size_t>(info.st_size));
+  }
+  // capacity counts the bytes available for records
+  m_capacity += existing == 0 ? k_header_size : existing;
+  if (::ftruncate(m_fd, static_cast<off_t>(m_capacity)) == -1) {
+    fail("resize");
+  }
+  auto const data = ::mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED) {
+    fail("map");
+  }
+  m_data = static_cast<std::byte*>(data);
+
+  // a log left by a crashed process still has its zero filled tail, so the
+  // end is found by walking the records rather than from the file size
+  std::size_t start = k_header_size;
+  if (existing == 0) {
+    auto out = put(m_data, k_magic);
+    out      = put(out, k_version);
+    put(out, std::uint32_t{0});
+  }
+  while (start + k_record_header <= existing) {
+    std::uint32_t size;
+    std::memcpy(&size, m_data + start, sizeof(size));
+    if (size == 0) {
+      break;
+    }
+    start += size;
+  }
+  m_offset.store(start, std::memory_order_relaxed);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+  // drop the unused part of the mapping, the zero after the last record
+  // still marks the end if the process dies before this point
+  auto const used = std::min(m_offset.load(), m_capacity);
+  ::msync(m_data, used, MS_SYNC);
+  ::munmap(m_data, m_capacity);
+  if (::ftruncate(m_fd, static_cast<off_t>(used)) == -1) {
+    // the file keeps its zero filled tail, which readers skip
+  }
+  ::close(m_fd);
+}
+
+std::byte* BinaryLogger::reserve(std::size_t size) const
+{
+  auto const offset = m_offset.fetch_add(size, std::memory_order_relaxed);
+  if (offset + size > m_capacity) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return m_data + offset;
+}
+
+std::uint32_t BinaryLogger::template_id(std::string_view fmt) const
+{
+  // templates are string literals, so their address identifies them
+  struct Cache
+  {
+    std::uint64_t instance = 0;
+    std::unordered_map<char const*, std::uint32_t> ids;
+  };
+  thread_local Cache cache;
+  if (cache.instance != m_instance) {
+    cache.instance = m_instance;
+    cache.ids.clear();
+  }
+  if (auto const it = cache.ids.find(fmt.data()); it != cache.ids.end()) {
+    return it->second;
+  }
+
+  std::lock_guard lock{m_mutex};
+  auto [it, inserted] = m_templates.try_emplace(
+      fmt, static_cast<std::uint32_t>(m_templates.size() + 1));
+  if (inserted) {
+    // written before any message can refer to it
+    auto const size = padded(k_record_header + 4 + fmt.size());
+    if (auto const record = reserve(size)) {
+      auto out = put(record + 4, RecordType::template_text);
+      out      = put(record + k_record_header, it->second);
+      std::memcpy(out, fmt.data(), fmt.size());
+      publish(record, size);
+    }
+  }
+  cache.ids.emplace(fmt.data(), it->second);
+  return it->second;
+}
+
+void BinaryLogger::write_message(Level log_level, std::uint32_t id,
+                                 std::span<LogArg const> args) const
+{
+  auto size = k_message_header;
+  for (auto const& arg : args) {
+    size += 1 + (is_text(arg) ? 4 + text_of(arg).size() : 8);
+  }
+  auto const record = reserve(padded(size));
+  if (record == nullptr) {
+    return;
+  }
+  auto const count = std::min<std::size_t>(args.size(), 255);
+
+  auto const now = std::chrono::system_clock::now().time_since_epoch();
+  auto const ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(now);
+  auto out       = put(record + 4, RecordType::message);
+  out            = put(out, static_cast<std::uint8_t>(log_level));
+  out            = put(out, static_cast<std::uint8_t>(count));
+  out            = put(record + k_record_header, std::int64_t{ns.count()});
+  out            = put(out, id);
+  for (auto const& arg : args.first(count)) {
+    // both string alternatives are stored as ArgType::string
+    auto const type = std::min<std::size_t>(arg.index(), 4);
+    out             = put(out, static_cast<ArgType>(type));
+    if (is_text(arg)) {
+      auto const text = text_of(arg);
+      out             = put(out, static_cast<std::uint32_t>(text.size()));
+      std::memcpy(out, text.data(), text.size());
+      out += text.size();
+    } else {
+      std::visit(
+          [&](auto const& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, bool>) {
+              out = put(out, std::uint64_t{value});
+            } else if constexpr (std::is_arithmetic_v<T>) {
+              out = put(out, value);
+            }
+          },
+          arg);
+    }
+  }
+  publish(record, padded(size));
+}
+
+void BinaryLogger::log(std::string_view const& msg, Level log_level) const
+{
+  if (log_level < m_log_level) {
+    return;
+  }
+  LogArg const text{std::in_place_type<std::string_view>, msg};
+  write_message(log_level, k_text_template, {&text, 1});
+}
+
+void BinaryLogger::log_structured(Level log_level, std::string_view fmt,
+                                  std::span<LogArg const> args) const
+{
+  if (log_level < m_log_level) {
+    return;
+  }
+  write_message(log_level, template_id(fmt), args);
+}
+
+std::size_t BinaryLogger::dropped() const
+{
+  return m_dropped.load(std::memory_order_relaxed);
+}
+
+std::string BinaryLogRecord::message() const
+{
+  return format_log_args(fmt, args);
+}
+
+BinaryLogReader::BinaryLogReader(std::filesystem::path const& path)
+{
+  std::ifstream file{path, std::ios::binary};
+  m_data.assign(std::istreambuf_iterator<char>{file}, {});
+  if (m_data.size() < BinaryLogger::k_header_size
+      || !std::equal(std::begin(BinaryLogger::k_magic),
+                     std::end(BinaryLogger::k_magic), m_data.begin())) {
+    throw std::runtime_error(
+        std::format("{} is not a binary log", path.string()));
+  }
+  m_templates[BinaryLogger::k_text_template] = "{}";
+}
+
+std::optional<BinaryLogRecord> BinaryLogReader::next()
+{
+  using RecordType = BinaryLogger::RecordType;
+  using ArgType    = BinaryLogger::ArgType;
+
+  while (m_offset + k_record_header <= m_data.size()) {
+    auto const record = m_data.data() + m_offset;
+    auto const size   = get<std::uint32_t>(record);
+    if (size < k_record_header || m_offset + size > m_data.size()) {
+      break;
+    }
+    m_offset += size;
+    auto const end = record + size;
+
+    auto const type = get<RecordType>(record + 4);
+    if (type == RecordType::template_text) {
+      if (size < k_record_header + 4) {
+        continue;
+      }
+      auto const id    = get<std::uint32_t>(record + k_record_header);
+      auto const begin = record + k_record_header + 4;
+      // the text is followed by zero padding
+      m_templates[id] = std::string_view{begin, std::find(begin, end, '\0')};
+      continue;
+    }
+    auto const level = get<std::uint8_t>(record + 5);
+    if (type != RecordType::message || size < k_message_header
+        || level > LoggerService::ERROR) {
+      continue;
+    }
+
+    BinaryLogRecord message;
+    message.level = static_cast<LoggerService::Level>(level);
+    auto const count = get<std::uint8_t>(record + 6);
+    auto const ns    = get<std::int64_t>(record + k_record_header);
+    message.time     = std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds{ns})};
+    auto const id = get<std::uint32_t>(record + k_record_header + 8);
+    if (auto const it = m_templates.find(id); it != m_templates.end()) {
+      message.fmt = it->second;
+    }
+
+    // a record whose arguments do not fit is corrupt and skipped whole
+    auto in    = record + k_message_header;
+    auto valid = true;
+    for (std::uint8_t i = 0; valid && i < count; ++i) {
+      if (in == end) {
+        valid = false;
+        break;
+      }
+      auto const type = get<ArgType>(in++);
+      if (type == ArgType::string) {
+        if (end - in < 4) {
+          valid = false;
+          break;
+        }
+        auto const length = get<std::uint32_t>(in);
+        in += 4;
+        if (static_cast<std::size_t>(end - in) < length) {
+          valid = false;
+          break;
+        }
+        message.args.emplace_back(std::string_view{in, length});
+        in += length;
+        continue;
+      }
+      if (end - in < 8) {
+        valid = false;
+        break;
+      }
+      switch (type) {
+      case ArgType::int64:
+        message.args.emplace_back(get<std::int64_t>(in));
+        break;
+      case ArgType::uint64:
+        message.args.emplace_back(get<std::uint64_t>(in));
+        break;
+      case ArgType::float64:
+        message.args.emplace_back(get<double>(in));
+        break;
+      case ArgType::boolean:
+        message.args.emplace_back(get<std::uint64_t>(in) != 0);
+        break;
+      default:
+        valid = false;
+        break;
+      }
+      in += 8;
+    }
+    if (!valid) {
+      continue;
+    }
+    return message;
+  }
+  return std::nullopt;
+}
+
+} // namespace isaac
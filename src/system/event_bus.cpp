@@ -0,0 +1,50 @@
+#include "isaac/system/event_bus.hpp"
+#include "isaac/system/profiler.hpp"
+
+#include <numeric>
+
+namespace isaac {
+
+std::size_t detail::next_event_type()
+{
+  static std::size_t s_next = 0;
+  return s_next++;
+}
+
+void EventBus::unsubscribe_all(void const* instance)
+{
+  for (auto const& queue : m_queues) {
+    if (queue != nullptr) {
+      queue->unsubscribe_all(instance);
+    }
+  }
+}
+
+std::size_t EventBus::drain()
+{
+  ISAAC_PROFILE_ZONE("EventBus::drain");
+  for (auto const& queue : m_queues) {
+    if (queue != nullptr) {
+      queue->mark();
+    }
+  }
+  // a queue created by a delegate starts empty, indices keep the loop valid
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < m_queues.size(); ++i) {
+    if (m_queues[i] != nullptr) {
+      count += m_queues[i]->dispatch();
+    }
+  }
+  ISAAC_PROFILE_COUNTER("events dispatched", count);
+  return count;
+}
+
+std::size_t EventBus::pending() const
+{
+  return std::accumulate(m_queues.begin(), m_queues.end(), std::size_t{0},
+                         [](std::size_t total, auto const& queue) {
+                           return queue ? total + queue->pending() : total;
+                         });
+}
+
+} // namespace isaac
@@ -10,7 +10,7 @@ namespace isaac {
 Input::Input()
 {
   auto logger = ServiceLocator<Logger>::get_service();
-  logger->debug("Input initialized");
+  ISAAC_LOG_DEBUG(*logger, "Input initialized");
 }
 
 void Input::on_notify(Observable<sf::Event>& subject, sf::Event const& event)
@@ -1,6 +1,10 @@
 #include "isaac/system/logger.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cstring>
+#include <ctime>
 #include <format>
 #include <iomanip>
 #include <iostream>
@@ -10,6 +14,63 @@
 #define USE_STDERR
 
 namespace isaac {
+
+namespace {
+
+long long milliseconds_of(std::chrono::system_clock::time_point time)
+{
+  using namespace std::chrono;
+  auto const since_epoch = time.time_since_epoch();
+  return duration_cast<milliseconds>(since_epoch - floor<seconds>(since_epoch))
+      .count();
+}
+
+} // namespace
+
+std::string format_log_args(std::string_view fmt, std::span<LogArg const> args)
+{
+  std::string text;
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < fmt.size(); ++i) {
+    auto const c = fmt[i];
+    if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c) {
+      text += c;
+      ++i;
+      continue;
+    }
+    auto const close = c == '{' ? fmt.find('}', i) : std::string_view::npos;
+    if (close == std::string_view::npos) {
+      text += c;
+      continue;
+    }
+
+    // "{}", "{1}", "{:.3f}" or "{1:.3f}"
+    auto const field = fmt.substr(i + 1, close - i - 1);
+    auto const colon = field.find(':');
+    auto const id    = field.substr(0, colon);
+    auto index       = next++;
+    std::from_chars(id.data(), id.data() + id.size(), index);
+    auto const spec = colon == std::string_view::npos
+                        ? std::string{"{}"}
+                        : std::format("{{{}}}", field.substr(colon));
+    if (index < args.size()) {
+      std::visit(
+          [&](auto const& value) {
+            try {
+              text += std::vformat(spec, std::make_format_args(value));
+            } catch (std::format_error const&) {
+              text += std::format("{}", value);
+            }
+          },
+          args[index]);
+    } else {
+      text += fmt.substr(i, close - i + 1);
+    }
+    i = close;
+  }
+  return text;
+}
+
 LoggerService::LoggerService(Level log_level, std::string fmt)
     : m_log_level{log_level}
     , m_fmt{std::move(fmt)}
@@ -17,13 +78,45 @@ LoggerService::LoggerService(Level log_level, std::string fmt)
 
 std::string LoggerService::get_current_time() const
 {
-  auto const now = std::chrono::system_clock::now();
-  auto t         = std::chrono::system_clock::to_time_t(now);
-  std::tm l_time{};
-  localtime_r(&t, &l_time);
-  std::stringstream ss{};
-  ss << std::put_time(&l_time, m_fmt.c_str());
-  return ss.str();
+  return format_time(std::chrono::system_clock::now());
+}
+
+std::string
+LoggerService::format_time(std::chrono::system_clock::time_point time) const
+{
+  return std::format("{}.{:03}", format_second(time), milliseconds_of(time));
+}
+
+std::string_view
+LoggerService::format_second(std::chrono::system_clock::time_point time) const
+{
+  // localtime_r and put_time only run when the second or the format changes,
+  // a burst of messages reuses the same text
+  struct Cache
+  {
+    std::time_t second = -1;
+    std::string fmt;
+    std::string text;
+  };
+  thread_local Cache cache;
+
+  auto const t = std::chrono::system_clock::to_time_t(time);
+  if (t != cache.second || cache.fmt != m_fmt) {
+    std::tm l_time{};
+    localtime_r(&t, &l_time);
+    std::stringstream ss{};
+    ss << std::put_time(&l_time, m_fmt.c_str());
+    cache.second = t;
+    cache.fmt    = m_fmt;
+    cache.text   = ss.str();
+  }
+  return cache.text;
+}
+
+void LoggerService::log_structured(Level log_level, std::string_view fmt,
+                                   std::span<LogArg const> args) const
+{
+  log(format_log_args(fmt, args), log_level);
 }
 
 // Logger
@@ -31,21 +124,30 @@ Logger::Logger(Level logLevel, std::string fmt)
     : LoggerService{logLevel, std::move(fmt)}
 {}
 
-void Logger::log(std::string_view const& msg, Level log_level) const
+std::string
+Logger::format_message(std::string_view msg, Level log_level,
+                       std::chrono::system_clock::time_point time) const
 {
-  if (log_level < m_log_level)
-    return;
-  auto current_time = get_current_time();
-  auto const message =
-      std::format("[{}] - {:<5} - {}", current_time, k_levels[log_level], msg);
+  return std::format("[{}.{:03}] - {:<5} - {}\n", format_second(time),
+                     milliseconds_of(time), k_levels[log_level], msg);
+}
 
+void Logger::write(std::string_view text)
+{
 #ifdef USE_STDERR
-  std::cerr << message << '\n';
+  std::cerr << text;
 #elif
-  std::cout << message << '\n';
+  std::cout << text;
 #endif
 }
 
+void Logger::log(std::string_view const& msg, Level log_level) const
+{
+  if (log_level < m_log_level)
+    return;
+  write(format_message(msg, log_level, std::chrono::system_clock::now()));
+}
+
 void Logger::debug(std::string_view const& msg) const
 {
   log(msg, DEBUG);
@@ -62,4 +164,161 @@ void Logger::error(std::string_view const& msg) const
 {
   log(msg, ERROR);
 }
+
+// AsyncLogger
+AsyncLogger::AsyncLogger(Level log_level, std::string fmt, Overflow overflow)
+    : Logger{log_level, std::move(fmt)}
+    , m_overflow{overflow}
+    , m_records{std::make_unique<Record[]>(k_capacity)}
+{
+  for (std::size_t i = 0; i < k_capacity; ++i) {
+    m_records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  m_writer = std::thread{[this] { run(); }};
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  m_stop.store(true);
+  m_signal.fetch_add(1);
+  m_signal.notify_one();
+  m_writer.join();
+}
+
+void AsyncLogger::log(std::string_view const& msg, Level log_level) const
+{
+  if (log_level < m_log_level) {
+    return;
+  }
+  while (!push(msg, log_level)) {
+    if (m_overflow == Overflow::drop) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    wake();
+    std::this_thread::yield();
+  }
+  wake();
+}
+
+// bounded multi producer queue, each slot carries the sequence number of the
+// position it is ready for
+bool AsyncLogger::push(std::string_view msg, Level log_level) const
+{
+  auto position = m_tail.load(std::memory_order_relaxed);
+  Record* record;
+  while (true) {
+    record              = &m_records[position % k_capacity];
+    auto const sequence = record->sequence.load(std::memory_order_acquire);
+    auto const diff     = static_cast<std::ptrdiff_t>(sequence - position);
+    if (diff == 0) {
+      if (m_tail.compare_exchange_weak(position, position + 1,
+                                       std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = m_tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto const size = std::min(msg.size(), k_max_message);
+  record->time    = std::chrono::system_clock::now();
+  record->level   = log_level;
+  record->size    = static_cast<std::uint16_t>(size);
+  std::memcpy(record->text, msg.data(), size);
+  if (size < msg.size()) {
+    std::memcpy(record->text + size - 3, "...", 3);
+  }
+  record->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+void AsyncLogger::wake() const
+{
+  // pairs with the fence in run(), either the writer sees the new record or
+  // it is seen sleeping here
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_sleeping.load(std::memory_order_relaxed)) {
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+  }
+}
+
+bool AsyncLogger::empty() const
+{
+  auto const head    = m_head.load(std::memory_order_relaxed);
+  auto const& record = m_records[head % k_capacity];
+  return record.sequence.load(std::memory_order_acquire) != head + 1;
+}
+
+// formats every ready record into one write, returns how many were read
+std::size_t AsyncLogger::drain()
+{
+  std::string text;
+  std::size_t count = 0;
+  auto head         = m_head.load(std::memory_order_relaxed);
+  while (true) {
+    auto& record = m_records[head % k_capacity];
+    if (record.sequence.load(std::memory_order_acquire) != head + 1) {
+      break;
+    }
+    text += format_message({record.text, record.size}, record.level,
+                           record.time);
+    record.sequence.store(head + k_capacity, std::memory_order_release);
+    ++head;
+    ++count;
+  }
+
+  auto const dropped = m_dropped.load(std::memory_order_relaxed);
+  if (dropped != m_dropped_reported) {
+    auto const msg = std::format("{} log messages dropped, queue full",
+                                 dropped - m_dropped_reported);
+    text += format_message(msg, WARN, std::chrono::system_clock::now());
+    m_dropped_reported = dropped;
+  }
+  if (!text.empty()) {
+    write(text);
+  }
+  // published once written, flush() waits on it
+  m_head.store(head, std::memory_order_release);
+  return count;
+}
+
+void AsyncLogger::run()
+{
+  while (true) {
+    if (drain() > 0) {
+      continue;
+    }
+    if (m_stop.load()) {
+      // anything logged while stopping
+      drain();
+      return;
+    }
+    auto const signal = m_signal.load(std::memory_order_acquire);
+    m_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (empty() && !m_stop.load()) {
+      m_signal.wait(signal);
+    }
+    m_sleeping.store(false, std::memory_order_relaxed);
+  }
+}
+
+void AsyncLogger::flush() const
+{
+  auto const target = m_tail.load(std::memory_order_acquire);
+  m_signal.fetch_add(1, std::memory_order_release);
+  m_signal.notify_one();
+  while (m_head.load(std::memory_order_acquire) < target) {
+    std::this_thread::yield();
+  }
+}
+
+std::size_t AsyncLogger::dropped() const
+{
+  return m_dropped.load(std::memory_order_relaxed);
+}
 } // namespace isaac
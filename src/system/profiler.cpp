@@ -0,0 +1,189 @@
+#include "isaac/system/profiler.hpp"
+#include "isaac/internal/demangle.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace isaac {
+
+namespace {
+
+float milliseconds(Profiler::Clock::duration duration)
+{
+  return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+// type names are demangled once, zones only keep the raw pointer
+char const* display_name(Profiler::Zone const& zone)
+{
+  if (!zone.type_name) {
+    return zone.name;
+  }
+  static std::unordered_map<char const*, std::string> names;
+  auto [it, inserted] = names.try_emplace(zone.name);
+  if (inserted) {
+    it->second = demangle(zone.name);
+  }
+  return it->second.c_str();
+}
+
+ImU32 color_of(char const* name)
+{
+  auto const hash = std::hash<std::string_view>{}(name);
+  auto const r    = 80 + static_cast<int>(hash & 0x7f);
+  auto const g    = 80 + static_cast<int>(hash >> 8 & 0x7f);
+  auto const b    = 80 + static_cast<int>(hash >> 16 & 0x7f);
+  return IM_COL32(r, g, b, 255);
+}
+
+} // namespace
+
+Profiler& Profiler::instance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::set_enabled(bool enabled)
+{
+  s_enabled = enabled;
+}
+
+void Profiler::begin_frame()
+{
+  if (!s_enabled) {
+    return;
+  }
+  m_current.zones.clear();
+  m_current.counters.clear();
+  m_current.dropped_zones = 0;
+  m_open.clear();
+  m_recording   = true;
+  m_frame_start = Clock::now();
+}
+
+void Profiler::end_frame()
+{
+  if (!m_recording) {
+    return;
+  }
+  m_recording        = false;
+  m_current.duration = Clock::now() - m_frame_start;
+
+  m_history[m_history_head] = milliseconds(m_current.duration);
+  m_history_head            = (m_history_head + 1) % k_history;
+  if (!m_paused) {
+    std::swap(m_current, m_last);
+  }
+}
+
+std::uint32_t Profiler::begin_zone(char const* name, bool type_name)
+{
+  if (!m_recording || m_current.zones.size() == k_max_zones
+      || m_open.size() == k_max_depth) {
+    m_current.dropped_zones += m_recording;
+    return k_no_zone;
+  }
+  auto const index = static_cast<std::uint32_t>(m_current.zones.size());
+  auto const begin = Clock::now() - m_frame_start;
+  auto const depth = static_cast<std::uint32_t>(m_open.size());
+  m_current.zones.push_back({name, depth, type_name, begin, begin});
+  m_open.push_back(index);
+  return index;
+}
+
+void Profiler::end_zone(std::uint32_t zone)
+{
+  // zones opened before a frame ended are left as they are
+  if (!m_recording || m_open.empty() || m_open.back() != zone) {
+    return;
+  }
+  m_current.zones[zone].end = Clock::now() - m_frame_start;
+  m_open.pop_back();
+}
+
+void Profiler::count(char const* name, std::int64_t value)
+{
+  if (!m_recording) {
+    return;
+  }
+  auto& counters = m_current.counters;
+  auto it        = std::ranges::find_if(counters, [&](auto const& counter) {
+    return std::string_view{counter.first} == name;
+  });
+  if (it == counters.end()) {
+    counters.emplace_back(name, value);
+  } else {
+    it->second += value;
+  }
+}
+
+Profiler::Frame const& Profiler::last_frame() const
+{
+  return m_last;
+}
+
+void Profiler::draw_window()
+{
+  ImGui::Begin("Profiler");
+  ImGui::Checkbox("Pause", &m_paused);
+  ImGui::SameLine();
+  ImGui::Text("frame %.2f ms", milliseconds(m_last.duration));
+  if (Tracer::enabled()) {
+    ImGui::SameLine();
+    if (ImGui::Button("Write trace")) {
+      Tracer::instance().flush();
+    }
+  }
+
+  auto const slowest = *std::ranges::max_element(m_history);
+  ImGui::PlotLines("##frames", m_history.data(), static_cast<int>(k_history),
+                   static_cast<int>(m_history_head), nullptr, 0.f,
+                   std::max(slowest, 1.f), ImVec2{0.f, 60.f});
+
+  // flame graph of the last frame, one row per nesting level
+  std::uint32_t rows = 0;
+  for (auto const& zone : m_last.zones) {
+    rows = std::max(rows, zone.depth + 1);
+  }
+  auto const row_height = ImGui::GetTextLineHeight() + 4.f;
+  auto const origin     = ImGui::GetCursorScreenPos();
+  auto const width      = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+  auto const frame      = std::max(milliseconds(m_last.duration), 1e-3f);
+  auto* const draw_list = ImGui::GetWindowDrawList();
+  for (auto const& zone : m_last.zones) {
+    auto const begin = milliseconds(zone.begin);
+    auto const end   = milliseconds(zone.end);
+    ImVec2 const min{origin.x + begin / frame * width,
+                     origin.y + zone.depth * row_height};
+    ImVec2 const max{origin.x + end / frame * width, min.y + row_height - 1.f};
+    if (max.x - min.x < 1.f) {
+      continue;
+    }
+    auto const name = display_name(zone);
+    draw_list->AddRectFilled(min, max, color_of(name));
+    draw_list->PushClipRect(min, max, true);
+    draw_list->AddText({min.x + 2.f, min.y + 2.f}, IM_COL32(0, 0, 0, 255),
+                       name);
+    draw_list->PopClipRect();
+    if (ImGui::IsMouseHoveringRect(min, max)) {
+      ImGui::SetTooltip("%s\n%.3f ms", name, end - begin);
+    }
+  }
+  ImGui::Dummy({width, rows * row_height});
+
+  for (auto const& [name, value] : m_last.counters) {
+    ImGui::Text("%s: %lld", name, static_cast<long long>(value));
+  }
+  if (m_last.dropped_zones > 0) {
+    ImGui::Text("%zu zones not recorded", m_last.dropped_zones);
+  }
+  ImGui::End();
+}
+
+} // namespace isaac
@@ -1 +1,283 @@
 #include "isaac/system/thread.hpp"
+#include "isaac/system/trace.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace isaac {
+
+void ParallelJob::reset(Fn* job_fn, void* job_context, int item_count,
+                        int min_block)
+{
+  fn      = job_fn;
+  context = job_context;
+  count   = item_count;
+  block   = std::max(min_block, 1);
+  next.store(0, std::memory_order_relaxed);
+  done.store(0, std::memory_order_relaxed);
+}
+
+bool ParallelJob::run(std::uint32_t worker)
+{
+  bool claimed = false;
+  while (true) {
+    auto const begin = next.fetch_add(block, std::memory_order_relaxed);
+    if (begin >= count) {
+      return claimed;
+    }
+    auto const end = std::min(begin + block, count);
+    ISAAC_TRACE_ZONE("ParallelJob::run");
+    fn(begin, end, worker, context);
+    done.fetch_add(end - begin, std::memory_order_release);
+    claimed = true;
+  }
+}
+
+bool ParallelJob::finished() const
+{
+  return done.load(std::memory_order_acquire) >= count;
+}
+
+WorkerPool::WorkerPool(std::size_t worker_count)
+{
+  if (worker_count == 0) {
+    worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  // worker 0 is the thread waiting on the jobs
+  for (std::uint32_t worker = 1; worker < worker_count; ++worker) {
+    m_threads.emplace_back([this, worker] { work(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  std::ranges::for_each(m_threads, [](auto& t) { t.join(); });
+}
+
+std::size_t WorkerPool::size() const
+{
+  return m_threads.size() + 1;
+}
+
+void WorkerPool::submit(ParallelJob& job)
+{
+  if (m_threads.empty()) {
+    return;
+  }
+  {
+    std::lock_guard lock{m_mutex};
+    m_jobs.push_back(&job);
+  }
+  m_cv.notify_all();
+}
+
+void WorkerPool::wait(ParallelJob& job)
+{
+  job.run(0);
+  while (!job.finished()) {
+    std::this_thread::yield();
+  }
+  if (m_threads.empty()) {
+    return;
+  }
+  {
+    std::lock_guard lock{m_mutex};
+    std::erase(m_jobs, &job);
+  }
+  // a worker may still be returning from the job
+  while (job.active.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+}
+
+void WorkerPool::work(std::uint32_t worker)
+{
+  Tracer::set_thread_name("worker");
+  while (true) {
+    ParallelJob* job = nullptr;
+    {
+      std::unique_lock lock{m_mutex};
+      m_cv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+      if (m_stop) {
+        return;
+      }
+      job = m_jobs.front();
+      job->active.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto const claimed = job->run(worker);
+    if (!claimed) {
+      // every block is claimed, stop handing the job out
+      std::lock_guard lock{m_mutex};
+      if (!m_jobs.empty() && m_jobs.front() == job) {
+        m_jobs.pop_front();
+      }
+    }
+    job->active.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+namespace {
+// the pool the current thread works for, and its index in it
+thread_local JobSystem const* t_job_system = nullptr;
+thread_local std::size_t t_job_worker      = 0;
+} // namespace
+
+bool JobCounter::done() const
+{
+  return m_pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(std::size_t worker_count)
+{
+  if (worker_count == 0) {
+    worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  for (std::size_t worker = 0; worker < worker_count; ++worker) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  // worker 0 is the thread waiting on the jobs
+  for (std::size_t worker = 1; worker < worker_count; ++worker) {
+    m_threads.emplace_back([this, worker] { work(worker); });
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  std::ranges::for_each(m_threads, [](auto& t) { t.join(); });
+}
+
+std::size_t JobSystem::size() const
+{
+  return m_queues.size();
+}
+
+std::size_t JobSystem::current_worker() const
+{
+  return t_job_system == this ? t_job_worker : 0;
+}
+
+void JobSystem::push(std::size_t worker, Job const& job)
+{
+  {
+    std::lock_guard lock{m_queues[worker]->mutex};
+    m_queues[worker]->jobs.push_back(job);
+    m_queued.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (!m_threads.empty()) {
+    // a worker checking m_queued under the lock either sees the job or is
+    // already waiting for this notification
+    { std::lock_guard lock{m_mutex}; }
+    m_cv.notify_one();
+  }
+}
+
+bool JobSystem::pop(std::size_t worker, Job& job)
+{
+  if (m_queued.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  {
+    auto& own = *m_queues[worker];
+    std::lock_guard lock{own.mutex};
+    if (!own.jobs.empty()) {
+      job = own.jobs.back();
+      own.jobs.pop_back();
+      m_queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  // the oldest jobs of a queue are its largest ranges
+  for (std::size_t i = 1; i < m_queues.size(); ++i) {
+    auto& victim = *m_queues[(worker + i) % m_queues.size()];
+    std::lock_guard lock{victim.mutex};
+    if (!victim.jobs.empty()) {
+      job = victim.jobs.front();
+      victim.jobs.pop_front();
+      m_queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::execute(std::size_t worker, Job job)
+{
+  auto& counter = *job.counter;
+  while (job.end - job.begin > job.grain) {
+    auto half  = job;
+    half.begin = job.begin + (job.end - job.begin) / 2;
+    job.end    = half.begin;
+    counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+    push(worker, half);
+  }
+  try {
+    ISAAC_TRACE_ZONE("JobSystem::execute");
+    job.fn(job.begin, job.end, job.context);
+  } catch (...) {
+    if (!counter.m_failed.exchange(true, std::memory_order_relaxed)) {
+      counter.m_error = std::current_exception();
+    }
+  }
+  counter.m_pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::run(JobCounter& counter, Job::Fn* fn, void* context,
+                    int count, int grain)
+{
+  if (count <= 0) {
+    return;
+  }
+  counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+  push(current_worker(),
+       Job{fn, context, 0, count, std::max(grain, 1), &counter});
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+  auto const worker = current_worker();
+  while (!counter.done()) {
+    Job job;
+    if (pop(worker, job)) {
+      execute(worker, job);
+    } else {
+      // the last jobs are running on other workers
+      std::this_thread::yield();
+    }
+  }
+  if (counter.m_failed.exchange(false, std::memory_order_relaxed)) {
+    std::rethrow_exception(std::exchange(counter.m_error, nullptr));
+  }
+}
+
+void JobSystem::work(std::size_t worker)
+{
+  t_job_system = this;
+  t_job_worker = worker;
+  Tracer::set_thread_name("job worker");
+  while (true) {
+    Job job;
+    if (pop(worker, job)) {
+      execute(worker, job);
+      continue;
+    }
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [&] {
+      return m_stop || m_queued.load(std::memory_order_relaxed) > 0;
+    });
+    if (m_stop) {
+      return;
+    }
+  }
+}
+
+} // namespace isaac
@@ -0,0 +1,196 @@
+#include "isaac/system/trace.hpp"
+#include "isaac/internal/demangle.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace isaac {
+
+namespace {
+
+// An Event whose fields flush() may read while the owning thread overwrites
+// them. Torn copies are detected from the buffer head and dropped
+struct Slot
+{
+  std::atomic<char const*> name{nullptr};
+  std::atomic<bool> type_name{false};
+  std::atomic<Tracer::Clock::rep> begin{0};
+  std::atomic<Tracer::Clock::rep> end{0};
+};
+
+} // namespace
+
+// Written by its thread only. head counts every event ever recorded, the
+// slot of an event is its count modulo the capacity.
+struct Tracer::Buffer
+{
+  std::uint32_t tid;
+  std::string thread_name;
+  std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(k_capacity);
+  std::atomic<std::uint64_t> head{0};
+};
+
+thread_local Tracer::Buffer* Tracer::t_buffer = nullptr;
+
+namespace {
+
+thread_local char const* t_thread_name = nullptr;
+
+std::string escape(std::string_view text)
+{
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (auto c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+double microseconds(Tracer::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+Tracer::Tracer()  = default;
+Tracer::~Tracer() = default;
+
+Tracer& Tracer::instance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::set_thread_name(char const* name)
+{
+  t_thread_name = name;
+}
+
+Tracer::Buffer& Tracer::local_buffer()
+{
+  if (t_buffer == nullptr) {
+    std::lock_guard lock{m_mutex};
+    auto const tid = static_cast<std::uint32_t>(m_buffers.size());
+    auto& buffer   = m_buffers.emplace_back(std::make_unique<Buffer>());
+    buffer->tid    = tid;
+    buffer->thread_name =
+        t_thread_name ? t_thread_name : std::format("thread {}", tid);
+    t_buffer = buffer.get();
+  }
+  return *t_buffer;
+}
+
+void Tracer::start(std::filesystem::path path)
+{
+  m_path  = std::move(path);
+  m_epoch = Clock::now();
+  s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop()
+{
+  s_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::record(char const* name, bool type_name, Clock::time_point begin,
+                    Clock::time_point end)
+{
+  constexpr auto relaxed = std::memory_order_relaxed;
+  auto& buffer           = local_buffer();
+  auto const head        = buffer.head.load(relaxed);
+  auto& slot             = buffer.slots[head % k_capacity];
+  // orders the head published by the previous event before the writes
+  // below, see flush()
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, relaxed);
+  slot.type_name.store(type_name, relaxed);
+  slot.begin.store(begin.time_since_epoch().count(), relaxed);
+  slot.end.store(end.time_since_epoch().count(), relaxed);
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool Tracer::flush()
+{
+  return flush(m_path);
+}
+
+bool Tracer::flush(std::filesystem::path const& path)
+{
+  std::ofstream file{path};
+  if (!file) {
+    return false;
+  }
+
+  // names are escaped, and demangled, once per distinct pointer
+  std::unordered_map<char const*, std::string> names;
+  auto const name_of = [&](Event const& event) -> std::string const& {
+    auto [it, inserted] = names.try_emplace(event.name);
+    if (inserted) {
+      it->second = escape(event.type_name ? demangle(event.name) : event.name);
+    }
+    return it->second;
+  };
+
+  std::vector<Event> events;
+  std::lock_guard lock{m_mutex};
+  file << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  auto separator = "\n";
+  for (auto const& buffer : m_buffers) {
+    file << separator
+         << std::format(R"({{"name":"thread_name","ph":"M","pid":1,)"
+                        R"("tid":{},"args":{{"name":"{}"}}}})",
+                        buffer->tid, escape(buffer->thread_name));
+    separator = ",\n";
+
+    // copy the ring, then drop what its thread overwrote in the meantime
+    constexpr auto relaxed = std::memory_order_relaxed;
+    auto const head        = buffer->head.load(std::memory_order_acquire);
+    auto const first       = head > k_capacity ? head - k_capacity : 0;
+    events.clear();
+    for (auto i = first; i < head; ++i) {
+      auto const& slot = buffer->slots[i % k_capacity];
+      events.push_back(
+          {slot.name.load(relaxed), slot.type_name.load(relaxed),
+           Clock::time_point{Clock::duration{slot.begin.load(relaxed)}},
+           Clock::time_point{Clock::duration{slot.end.load(relaxed)}}});
+    }
+    // a copy holding a write of event i + k_capacity, the next one in its
+    // slot, pairs with the fence in record(): head is then seen at least at
+    // i + k_capacity, and every event up to after - k_capacity is suspect
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto const after = buffer->head.load(relaxed);
+    auto const valid = after >= k_capacity ? after - k_capacity + 1 : 0;
+    auto const skip  = std::min<std::uint64_t>(
+        valid > first ? valid - first : 0, events.size());
+
+    for (auto it = events.begin() + skip; it != events.end(); ++it) {
+      if (it->begin < m_epoch) {
+        continue;
+      }
+      file << separator
+           << std::format(R"({{"name":"{}","cat":"isaac","ph":"X","pid":1,)"
+                          R"("tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                          name_of(*it), buffer->tid,
+                          microseconds(it->begin - m_epoch),
+                          microseconds(it->end - it->begin));
+    }
+  }
+  file << "\n]}\n";
+  return static_cast<bool>(file);
+}
+
+std::filesystem::path const& Tracer::path() const
+{
+  return m_path;
+}
+
+} // namespace isaac
@@ -1,9 +1,17 @@
 #include "isaac/system/world.hpp"
+#include "isaac/components/collision_object_2d.hpp"
+#include "isaac/components/component_pool.hpp"
+#include "isaac/components/rigidbody_2d.hpp"
+#include "isaac/components/shape_renderer.hpp"
 #include "isaac/physics/physics_2d.hpp"
 #include "isaac/render/window_server.hpp"
 #include "isaac/scene/scene_manager.hpp"
+#include "isaac/system/defaults.hpp"
+#include "isaac/system/event_bus.hpp"
 #include "isaac/system/input.hpp"
+#include "isaac/system/profiler.hpp"
 #include "isaac/system/service_locator.hpp"
+#include "isaac/system/thread.hpp"
 
 #include <SFML/Window/Event.hpp>
 
@@ -12,25 +20,30 @@
 
 #include <algorithm>
 #include <cassert>
+#include <format>
 #include <stdexcept>
 
 namespace isaac {
 
 World::World(WindowServer& window_server, SceneManager& scene_manager,
              PhysicsServer2D& physics_server)
-    : m_window{window_server.get_window()}
+    : m_headless{window_server.headless()}
+    , m_window{window_server.get_window()}
     , m_scene_manager{scene_manager}
     , m_physics_server_2d{physics_server}
+    , m_event_bus{*ServiceLocator<EventBus>::get_service()}
+    , m_jobs{*ServiceLocator<JobSystem>::get_service()}
     , m_logger{*ServiceLocator<Logger>::get_service()}
 
 {
-  m_logger.debug("World initialized");
+  set_fixed_update_rate(Defaults::k_fixed_update_rate);
+  ISAAC_LOG_DEBUG(m_logger, "World initialized");
 }
 
 World::~World()
 {
   clear();
-  m_logger.debug("World destroyed");
+  ISAAC_LOG_DEBUG(m_logger, "World destroyed");
 }
 
 void World::start()
@@ -45,26 +58,63 @@ void World::start()
   auto& game_objects = scene->root().get_children();
 }
 
-void World::game_loop()
+void World::game_loop(std::size_t ticks)
 {
-  m_logger.debug("Start game loop");
-  while (m_window.isOpen()) {
+  ISAAC_LOG_DEBUG(m_logger, "Start game loop");
+  // headless ticks run back to back, each one advancing a single step
+  auto const headless_delta =
+      fixed_timestep() ? m_fixed_delta
+                       : sf::seconds(1.f / Defaults::k_fixed_update_rate);
+  sf::Clock loop_clock{};
+  std::size_t tick = 0;
+  Tracer::set_thread_name("main");
+
+  m_running = true;
+  for (; running() && (ticks == 0 || tick < ticks); ++tick) {
+    if constexpr (k_profiler) {
+      Profiler::instance().begin_frame();
+    }
+    ISAAC_TRACE_ZONE("frame");
     m_frame_time = m_frame_clock.restart();
-    m_window.clear();
-    input();
-    update();
-    render();
+    if (m_headless) {
+      step(headless_delta.asSeconds());
+      dispatch_events();
+    } else {
+      m_window.clear();
+      input();
+      update();
+      dispatch_events();
+      render();
+    }
     destroy_queued();
+    if constexpr (k_profiler) {
+      Profiler::instance().end_frame();
+    }
   }
-  m_logger.debug("Game loop stopped");
+  m_running = false;
+
+  auto const elapsed = loop_clock.getElapsedTime().asSeconds();
+  ISAAC_LOG_DEBUG(m_logger, "Game loop stopped after {} ticks in {:.3f}s",
+                  tick, elapsed);
+}
+
+void World::stop()
+{
+  m_running = false;
+}
+
+bool World::running() const
+{
+  return m_running && (m_headless || m_window.isOpen());
 }
 
 void World::input()
 {
+  ISAAC_PROFILE_ZONE("World::input");
   while (auto const event = m_window.pollEvent()) {
     ImGui::SFML::ProcessEvent(m_window, *event);
     if (event->is<sf::Event::Closed>()) {
-      m_logger.debug("Closing window");
+      ISAAC_LOG_DEBUG(m_logger, "Closing window");
       m_window.close();
     }
     notify(event.value());
@@ -73,26 +123,109 @@ void World::input()
 
 void World::update()
 {
-  m_physics_server_2d.update(m_frame_time.asSeconds());
+  ISAAC_PROFILE_ZONE("World::update");
+  if (!fixed_timestep()) {
+    step(m_frame_time.asSeconds());
+    m_alpha = 1.f;
+    return;
+  }
+
+  // consume the elapsed time in fixed slices, the remainder is carried over
+  // and used to interpolate between the last two simulated states
+  auto const max_frame_time = sf::seconds(Defaults::k_max_frame_time);
+  m_accumulator += std::min(m_frame_time, max_frame_time);
+  while (m_accumulator >= m_fixed_delta) {
+    step(m_fixed_delta.asSeconds());
+    m_accumulator -= m_fixed_delta;
+    ISAAC_PROFILE_COUNTER("fixed steps", 1);
+  }
+  m_alpha = m_accumulator / m_fixed_delta;
+}
+
+void World::step(float delta)
+{
+  ISAAC_PROFILE_ZONE("World::step");
   auto current_scene = m_scene_manager.get_current_scene();
   assert(current_scene && "current scene is null");
   auto& root         = current_scene->root();
   auto& game_objects = root.get_children();
-  std::ranges::for_each(game_objects, [&](auto& game_object) {
-    game_object->update(m_frame_time.asSeconds());
-  });
+  root.propagate_transform();
+  root.save_transform();
+  m_physics_server_2d.update(delta);
+  update_parallel(root, delta);
+  std::ranges::for_each(game_objects,
+                        [&](auto& game_object) { game_object->update(delta); });
+  if constexpr (k_component_pools) {
+    ISAAC_PROFILE_ZONE("ComponentPool::update");
+    // built-in components run after every on_update, one pass per type
+    ComponentPool<RigidBody2D>::instance().update();
+    ComponentPool<CollisionObject2D>::instance().update();
+    ComponentPool<ShapeRenderer>::instance().update();
+  }
+  // one pass for everything moved during the step
+  root.propagate_transform();
+}
+
+// on_parallel_update of every top-level subtree opting in, the subtrees
+// spread over the job workers
+void World::update_parallel(GameObject& root, float delta)
+{
+  if (!root.m_parallel_children) {
+    return;
+  }
+  ISAAC_PROFILE_ZONE("World::update_parallel");
+  m_parallel_subtrees.clear();
+  for (auto const& game_object : root.get_children()) {
+    if (game_object->m_parallel_update || game_object->m_parallel_children) {
+      m_parallel_subtrees.push_back(game_object.get());
+    }
+  }
+  // with the root flagged, objects moved concurrently stop marking their
+  // ancestors before reaching it
+  root.m_children_dirty = true;
+  m_jobs.parallel_for(static_cast<int>(m_parallel_subtrees.size()), 1,
+                      [&](int begin, int end) {
+                        for (auto i = begin; i < end; ++i) {
+                          m_parallel_subtrees[i]->update_parallel(delta);
+                        }
+                      });
+  root.m_parallel_children =
+      std::ranges::any_of(m_parallel_subtrees, [](auto const* game_object) {
+        return game_object->m_parallel_update
+               || game_object->m_parallel_children;
+      });
+}
+
+// events queued by the simulation are delivered once per frame, however
+// many fixed steps ran
+void World::dispatch_events()
+{
+  m_event_bus.drain();
 }
 
 void World::render()
 {
+  ISAAC_PROFILE_ZONE("World::render");
   auto current_scene = m_scene_manager.get_current_scene();
   assert(current_scene && "current scene is null");
   auto& root         = current_scene->root();
   auto& game_objects = root.get_children();
 
+  root.propagate_transform();
   ImGui::SFML::Update(m_window, m_frame_time);
-  std::ranges::for_each(
-      game_objects, [&](auto& game_object) { game_object->draw(m_window); });
+  std::ranges::for_each(game_objects, [&](auto& game_object) {
+    game_object->draw(m_window, m_alpha);
+  });
+  ISAAC_PROFILE_COUNTER("batched vertices",
+                        ShapeRenderer::batch().vertex_count());
+  // the shapes batched since the last draw that was not batched
+  ShapeRenderer::flush(m_window);
+  m_physics_server_2d.debug_draw(m_window);
+  if constexpr (k_profiler) {
+    if (Profiler::enabled()) {
+      Profiler::instance().draw_window();
+    }
+  }
 
   // this silence the error 'Failed to set render target inactive' caused by
   // window.close()
@@ -104,16 +237,25 @@ void World::render()
 
 void World::destroy_queued()
 {
-  auto current_scene = m_scene_manager.get_current_scene();
-  assert(current_scene && "current scene is null");
-  auto& root = current_scene->root();
-  root.destroy_queued();
+  ISAAC_PROFILE_ZONE("World::destroy_queued");
+  GameObject::destroy_queued();
 }
 
 void World::clear()
 {
-  m_logger.debug("Clearing World");
+  ISAAC_LOG_DEBUG(m_logger, "Clearing World");
   auto current_scene = m_scene_manager.get_current_scene();
   current_scene->root().m_children.clear();
 }
+
+void World::set_fixed_update_rate(float update_rate)
+{
+  m_fixed_delta = update_rate > 0 ? sf::seconds(1.f / update_rate) : sf::Time{};
+  m_accumulator = sf::Time{};
+}
+
+bool World::fixed_timestep() const
+{
+  return m_fixed_delta > sf::Time{};
+}
 } // namespace isaac
@@ -0,0 +1,129 @@
+#include "doctest.h"
+
+#include "isaac/system/binary_logger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace isaac;
+
+TEST_CASE("Binary log records read back with their arguments")
+{
+  auto const path =
+      std::filesystem::temp_directory_path() / "isaac_binary_logger.t.bin";
+  std::filesystem::remove(path);
+  {
+    BinaryLogger logger{path, LoggerService::DEBUG, 4096};
+    ISAAC_LOG_INFO(logger, "spawned {} at {:.1f}", "ball", 2.25);
+    logger.warn("plain text");
+  }
+  {
+    // reopening appends to the same file
+    BinaryLogger logger{path};
+    ISAAC_LOG_ERROR(logger, "{} left, done {}", -3, true);
+  }
+
+  BinaryLogReader reader{path};
+  auto record = reader.next();
+  REQUIRE(record);
+  CHECK(record->level == LoggerService::INFO);
+  CHECK(record->fmt == "spawned {} at {:.1f}");
+  REQUIRE(record->args.size() == 2);
+  CHECK(std::get<std::string_view>(record->args[0]) == "ball");
+  CHECK(std::get<double>(record->args[1]) == 2.25);
+  CHECK(record->message() == "spawned ball at 2.2");
+
+  record = reader.next();
+  REQUIRE(record);
+  CHECK(record->level == LoggerService::WARN);
+  CHECK(record->message() == "plain text");
+
+  record = reader.next();
+  REQUIRE(record);
+  CHECK(record->message() == "-3 left, done true");
+  CHECK_FALSE(reader.next());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary logger drops messages past its capacity")
+{
+  auto const path =
+      std::filesystem::temp_directory_path() / "isaac_binary_logger_full.bin";
+  std::filesystem::remove(path);
+  {
+    BinaryLogger logger{path, LoggerService::DEBUG, 64};
+    for (int i = 0; i < 8; ++i) {
+      ISAAC_LOG_INFO(logger, "message {}", i);
+    }
+    CHECK(logger.dropped() > 0);
+  }
+  BinaryLogReader reader{path};
+  std::size_t count = 0;
+  while (reader.next()) {
+    ++count;
+  }
+  CHECK(count > 0);
+  CHECK(count < 8);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary log reader skips records with arguments out of bounds")
+{
+  auto const path =
+      std::filesystem::temp_directory_path() / "isaac_binary_logger_bad.bin";
+  std::filesystem::remove(path);
+  {
+    BinaryLogger logger{path, LoggerService::DEBUG, 4096};
+    ISAAC_LOG_INFO(logger, "spawned {}", "ball");
+    logger.warn("plain text");
+  }
+  {
+    // the length of the string argument now runs past its record
+    std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+    std::string const data{std::istreambuf_iterator<char>{file}, {}};
+    auto const ball = data.find("ball");
+    REQUIRE(ball != std::string::npos);
+    file.seekp(static_cast<std::streamoff>(ball - 4));
+    file.write("\xff\xff\xff\x7f", 4);
+  }
+
+  BinaryLogReader reader{path};
+  auto const record = reader.next();
+  REQUIRE(record);
+  CHECK(record->message() == "plain text");
+  CHECK_FALSE(reader.next());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary log reader skips records with an unknown level")
+{
+  auto const path = std::filesystem::temp_directory_path()
+                  / "isaac_binary_logger_level.bin";
+  std::filesystem::remove(path);
+  {
+    BinaryLogger logger{path, LoggerService::DEBUG, 4096};
+    logger.warn("first");
+    logger.warn("second");
+  }
+  {
+    // plain text is the only argument, its type and length come after the
+    // 20 bytes of message header
+    std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+    std::string const data{std::istreambuf_iterator<char>{file}, {}};
+    auto const first = data.find("first");
+    REQUIRE(first != std::string::npos);
+    auto const level = first - 25 + 5;
+    file.seekp(static_cast<std::streamoff>(level));
+    file.put('\x2a');
+  }
+
+  BinaryLogReader reader{path};
+  auto const record = reader.next();
+  REQUIRE(record);
+  CHECK(record->message() == "second");
+  CHECK_FALSE(reader.next());
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,58 @@
+#include "doctest.h"
+
+#include "isaac/components/collision_object_2d.hpp"
+#include "isaac/components/game_object.hpp"
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/debug_draw_2d.hpp"
+#include "isaac/physics/physics_2d.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/service_locator.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
+
+using namespace isaac;
+
+TEST_CASE("Debug draw collects only the bodies in view")
+{
+  auto logger  = ServiceLocator<Logger>::register_service(Logger::ERROR);
+  auto physics = ServiceLocator<PhysicsServer2D>::register_service();
+  GameObject root;
+  // two 20x20 boxes, far apart
+  auto& inside = root.make_child<GameObject>();
+  inside.set_position({100.f, 100.f});
+  auto& inside_body =
+      inside.make_component<CollisionObject2D>(Box2DShape{{20.f, 20.f}});
+  inside_body.update(inside);
+  auto& outside = root.make_child<GameObject>();
+  outside.set_position({5000.f, 5000.f});
+  auto& outside_body =
+      outside.make_component<CollisionObject2D>(Box2DShape{{20.f, 20.f}});
+  outside_body.update(outside);
+
+  DebugDraw2D batch;
+  physics->debug_draw(batch,
+                      sf::View{sf::FloatRect{{0.f, 0.f}, {800.f, 600.f}}});
+  auto const one = batch.vertex_count();
+  CHECK(one > 0);
+  batch.clear();
+  CHECK(batch.vertex_count() == 0);
+
+  // nothing in view
+  physics->debug_draw(batch,
+                      sf::View{sf::FloatRect{{-900.f, 0.f}, {800.f, 600.f}}});
+  CHECK(batch.vertex_count() == 0);
+  batch.clear();
+
+  // both in view
+  physics->debug_draw(batch,
+                      sf::View{sf::FloatRect{{0.f, 0.f}, {6000.f, 6000.f}}});
+  CHECK(batch.vertex_count() == 2 * one);
+  batch.clear();
+
+  // shapes off
+  batch.set_draw_shapes(false);
+  physics->debug_draw(batch,
+                      sf::View{sf::FloatRect{{0.f, 0.f}, {6000.f, 6000.f}}});
+  CHECK(batch.vertex_count() == 0);
+}
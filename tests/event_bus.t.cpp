@@ -0,0 +1,92 @@
+#include "doctest.h"
+
+#include "isaac/system/event_bus.hpp"
+
+#include <vector>
+
+using namespace isaac;
+
+namespace {
+
+struct Hit
+{
+  int damage = 0;
+};
+
+struct Listener
+{
+  EventBus* bus = nullptr;
+  std::vector<int> received;
+  bool leave    = false;
+  bool echo     = false;
+
+  void on_hit(Hit const& hit)
+  {
+    received.push_back(hit.damage);
+    if (leave) {
+      bus->unsubscribe<&Listener::on_hit>(*this);
+    }
+    if (echo) {
+      bus->publish(Hit{hit.damage + 1});
+    }
+  }
+};
+
+} // namespace
+
+TEST_CASE("Events are delivered when the bus is drained")
+{
+  EventBus bus;
+  Listener listener{&bus};
+  bus.subscribe<&Listener::on_hit>(listener);
+
+  // more than the initial capacity, the ring grows and keeps the order
+  for (int i = 0; i < 100; ++i) {
+    bus.publish(Hit{i});
+  }
+  CHECK(listener.received.empty());
+  CHECK(bus.pending() == 100);
+  CHECK(bus.drain() == 100);
+  REQUIRE(listener.received.size() == 100);
+  CHECK(listener.received.front() == 0);
+  CHECK(listener.received.back() == 99);
+
+  bus.send(Hit{7});
+  CHECK(listener.received.back() == 7);
+}
+
+TEST_CASE("Events published while draining wait for the next drain")
+{
+  EventBus bus;
+  Listener listener{&bus};
+  listener.echo = true;
+  bus.subscribe<&Listener::on_hit>(listener);
+
+  bus.publish(Hit{1});
+  CHECK(bus.drain() == 1);
+  CHECK(listener.received == std::vector{1});
+  CHECK(bus.pending() == 1);
+  CHECK(bus.drain() == 1);
+  CHECK(listener.received == std::vector{1, 2});
+}
+
+TEST_CASE("A delegate may unsubscribe itself while dispatching")
+{
+  EventBus bus;
+  Listener first{&bus};
+  Listener second{&bus};
+  first.leave = true;
+  bus.subscribe<&Listener::on_hit>(first);
+  bus.subscribe<&Listener::on_hit>(second);
+
+  bus.publish(Hit{1});
+  bus.publish(Hit{2});
+  bus.drain();
+  CHECK(first.received == std::vector{1});
+  CHECK(second.received == std::vector{1, 2});
+
+  bus.unsubscribe_all(&second);
+  bus.publish(Hit{3});
+  bus.drain();
+  CHECK(second.received == std::vector{1, 2});
+}
@@ -0,0 +1,98 @@
+#include "doctest.h"
+
+#include "isaac/components/game_object.hpp"
+#include "isaac/isaac.hpp"
+#include "isaac/scene/scene.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace isaac;
+
+TEST_CASE("Global positions follow moved ancestors")
+{
+  GameObject root;
+  auto& parent = root.make_child<GameObject>();
+  auto& child  = parent.make_child<GameObject>();
+  auto& leaf   = child.make_child<GameObject>();
+
+  parent.set_position({10.f, 0.f});
+  child.set_position({0.f, 5.f});
+  leaf.set_position({1.f, 1.f});
+  CHECK(leaf.get_global_position() == sf::Vector2f{11.f, 6.f});
+
+  // moving the top is seen by the whole subtree, propagated or not
+  root.set_position({100.f, 100.f});
+  CHECK(child.get_global_position() == sf::Vector2f{110.f, 105.f});
+  CHECK(leaf.get_global_position() == sf::Vector2f{111.f, 106.f});
+
+  leaf.set_global_position({0.f, 0.f});
+  CHECK(leaf.get_position() == sf::Vector2f{-110.f, -105.f});
+  CHECK(leaf.get_global_position() == sf::Vector2f{0.f, 0.f});
+  CHECK(child.get_global_position() == sf::Vector2f{110.f, 105.f});
+}
+
+TEST_CASE("Rotation and scale are inherited")
+{
+  GameObject root;
+  auto& parent = root.make_child<GameObject>();
+  auto& child  = parent.make_child<GameObject>();
+
+  parent.set_position({5.f, 5.f});
+  parent.set_rotation(sf::degrees(90.f));
+  parent.set_scale({2.f, 2.f});
+  child.set_position({10.f, 0.f});
+
+  auto const global = child.get_global_position();
+  CHECK(global.x == doctest::Approx(5.f));
+  CHECK(global.y == doctest::Approx(25.f));
+  CHECK(child.get_global_rotation().asDegrees() == doctest::Approx(90.f));
+
+  child.set_global_position({5.f, 5.f});
+  CHECK(child.get_position().x == doctest::Approx(0.f));
+  CHECK(child.get_position().y == doctest::Approx(0.f));
+  child.set_global_rotation(sf::degrees(30.f));
+  CHECK(child.get_rotation().asDegrees() == doctest::Approx(-60.f));
+}
+
+TEST_CASE("A world step caches the world matrices of the tree")
+{
+  Isaac isaac{headless, Logger::ERROR};
+  auto scene = std::make_unique<Scene>();
+  auto& root = scene->root();
+
+  // seven objects per level, so the batched composition has a scalar tail
+  std::vector<std::pair<GameObject*, Matrix2D>> objects;
+  std::vector<std::pair<GameObject*, Matrix2D>> level{{&root, Matrix2D{}}};
+  for (int depth = 0; depth < 3; ++depth) {
+    std::vector<std::pair<GameObject*, Matrix2D>> next;
+    for (int i = 0; i < 7; ++i) {
+      auto& [parent, parent_world] = level[i % level.size()];
+      auto const f                 = static_cast<float>(i + depth);
+      auto& child                  = parent->make_child<GameObject>();
+      child.set_position({10.f * f, -3.f * f});
+      child.set_rotation(sf::degrees(20.f * f - 30.f));
+      child.set_scale({1.f + f / 10.f, 0.5f + f / 5.f});
+      auto const local =
+          Matrix2D::from(child.get_position(), child.get_rotation(),
+                         child.get_scale());
+      next.emplace_back(&child, parent_world * local);
+    }
+    objects.insert(objects.end(), next.begin(), next.end());
+    level = std::move(next);
+  }
+
+  isaac.set_scene(std::move(scene));
+  isaac.run(1);
+  // nothing is dirty after the step, the cached matrices are returned
+  for (auto const& [object, expected] : objects) {
+    auto const world = object->get_global_transform();
+    CHECK(world.a == doctest::Approx(expected.a));
+    CHECK(world.b == doctest::Approx(expected.b));
+    CHECK(world.c == doctest::Approx(expected.c));
+    CHECK(world.d == doctest::Approx(expected.d));
+    CHECK(world.tx == doctest::Approx(expected.tx).epsilon(1e-4));
+    CHECK(world.ty == doctest::Approx(expected.ty).epsilon(1e-4));
+  }
+}
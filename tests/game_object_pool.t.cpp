@@ -0,0 +1,146 @@
+#include "doctest.h"
+
+#include "isaac/components/component.hpp"
+#include "isaac/components/game_object.hpp"
+#include "isaac/components/game_object_pool.hpp"
+#include "isaac/components/rigidbody_2d.hpp"
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/physics_2d.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/service_locator.hpp"
+
+#include <box2d/box2d.h>
+
+#include <utility>
+
+using namespace isaac;
+
+namespace {
+
+struct Switch : Component
+{
+  int enabled  = 0;
+  int disabled = 0;
+
+  void enable(GameObject&) override
+  {
+    ++enabled;
+  }
+  void disable(GameObject&) override
+  {
+    ++disabled;
+  }
+};
+
+class Bullet : public GameObject
+{
+  void on_enable() override
+  {
+    ++respawns;
+    set_position({0.f, 0.f});
+  }
+
+ public:
+  int respawns   = 0;
+  Switch* toggle = nullptr;
+
+  Bullet()
+  {
+    toggle = &make_component<Switch>();
+  }
+};
+
+struct Ball : RigidBody2D
+{
+  Ball()
+      : RigidBody2D{Circle2DShape{1.f}}
+  {}
+  [[nodiscard]] b2BodyId id() const
+  {
+    return m_body_id;
+  }
+};
+
+class Shot : public GameObject
+{
+ public:
+  Ball* body = nullptr;
+
+  Shot()
+  {
+    body = &make_component<Ball>();
+  }
+};
+
+} // namespace
+
+TEST_CASE("Disabling a parent deactivates its subtree")
+{
+  GameObject root;
+  auto& parent = root.make_child<GameObject>();
+  auto& child  = parent.make_child<Bullet>();
+
+  parent.disable();
+  CHECK_FALSE(child.active());
+  CHECK(child.enabled());
+  CHECK(child.toggle->disabled == 1);
+  CHECK_FALSE(child.toggle->active());
+
+  // disabled on its own, the child stays so when the parent comes back
+  child.disable();
+  parent.enable();
+  CHECK_FALSE(child.active());
+  CHECK(child.toggle->enabled == 0);
+  child.enable();
+  CHECK(child.active());
+  CHECK(child.toggle->enabled == 1);
+  CHECK(child.respawns == 1);
+}
+
+TEST_CASE("GameObjectPool recycles released objects")
+{
+  GameObject root;
+  GameObjectPool<Bullet> pool{root};
+  pool.reserve(2);
+  CHECK(pool.parked() == 2);
+  CHECK(std::as_const(root).get_children().size() == 2);
+
+  auto& a = pool.acquire();
+  CHECK(a.active());
+  a.set_position({50.f, 50.f});
+  pool.release(a);
+  pool.release(a);
+  CHECK(pool.parked() == 2);
+  CHECK_FALSE(a.active());
+
+  // the last object parked is handed out first, reset by on_enable
+  auto& b = pool.acquire();
+  CHECK(&b == &a);
+  CHECK(b.get_position() == sf::Vector2f{0.f, 0.f});
+  pool.acquire();
+  pool.acquire();
+  CHECK(std::as_const(root).get_children().size() == 3);
+}
+
+TEST_CASE("A recycled rigid body comes back at rest")
+{
+  auto logger  = ServiceLocator<Logger>::register_service(Logger::ERROR);
+  auto physics = ServiceLocator<PhysicsServer2D>::register_service();
+  GameObject root;
+  GameObjectPool<Shot> pool{root};
+
+  auto& shot    = pool.acquire();
+  auto const id = shot.body->id();
+  b2Body_SetLinearVelocity(id, {300.f, -20.f});
+  b2Body_SetAngularVelocity(id, 4.f);
+  pool.release(shot);
+  CHECK_FALSE(b2Body_IsEnabled(id));
+
+  auto& again = pool.acquire();
+  REQUIRE(&again == &shot);
+  CHECK(b2Body_IsEnabled(id));
+  auto const velocity = b2Body_GetLinearVelocity(id);
+  CHECK(velocity.x == doctest::Approx(0.f));
+  CHECK(velocity.y == doctest::Approx(0.f));
+  CHECK(b2Body_GetAngularVelocity(id) == doctest::Approx(0.f));
+}
@@ -0,0 +1,84 @@
+#include "doctest.h"
+
+#include "isaac/internal/base_object.hpp"
+#include "isaac/internal/object_registry.hpp"
+
+#include <memory>
+
+using namespace isaac;
+
+TEST_CASE("Registry resolves live objects and rejects stale handles")
+{
+  auto& registry    = ObjectRegistry::instance();
+  auto const before = registry.size();
+
+  auto object       = std::make_unique<BaseObject>();
+  auto const handle = object->handle();
+  CHECK(registry.size() == before + 1);
+  CHECK(registry.get(handle) == object.get());
+
+  object.reset();
+  CHECK(registry.size() == before);
+  CHECK_FALSE(registry.alive(handle));
+  CHECK(registry.get(handle) == nullptr);
+
+  // the slot is recycled with a new generation
+  BaseObject other;
+  CHECK(other.handle().index == handle.index);
+  CHECK(other.handle() != handle);
+  CHECK(registry.get(handle) == nullptr);
+  CHECK(registry.get(other.handle()) == &other);
+}
+
+TEST_CASE("Handles round trip through their packed value")
+{
+  BaseObject object;
+  auto const handle = object.handle();
+  CHECK(ObjectHandle::from_value(handle.value()) == handle);
+  CHECK(object.id() == handle.value());
+  CHECK(handle.value() != 0);
+}
+
+TEST_CASE("Typed handles become empty when the object dies")
+{
+  Handle<BaseObject> handle;
+  CHECK_FALSE(handle);
+  {
+    BaseObject object;
+    handle = object;
+    CHECK(handle);
+    CHECK(handle.get() == &object);
+  }
+  CHECK_FALSE(handle);
+  CHECK(handle.get() == nullptr);
+}
+
+TEST_CASE("Copies get their own identity")
+{
+  BaseObject original;
+  BaseObject copy{original};
+  CHECK(copy.id() != original.id());
+  CHECK(ObjectRegistry::instance().get(copy.handle()) == &copy);
+}
+
+TEST_CASE("Moves take the handle over")
+{
+  BaseObject original;
+  auto const handle = original.handle();
+  Handle<BaseObject> const typed{original};
+  BaseObject moved{std::move(original)};
+  CHECK(moved.handle() == handle);
+  CHECK(typed.get() == &moved);
+  // the moved from object is still registered, under a new handle
+  CHECK(original.handle() != handle);
+  CHECK(ObjectRegistry::instance().get(original.handle()) == &original);
+}
+
+TEST_CASE("Handles round trip through their pointer value")
+{
+  auto object      = std::make_unique<BaseObject>();
+  auto const value = object->handle().pointer_value();
+  CHECK(ObjectRegistry::instance().from_pointer_value(value) == object.get());
+  object.reset();
+  CHECK(ObjectRegistry::instance().from_pointer_value(value) == nullptr);
+}
@@ -0,0 +1,78 @@
+#include "doctest.h"
+
+#include "isaac/components/collision_object_2d.hpp"
+#include "isaac/components/game_object.hpp"
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/physics_2d.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/service_locator.hpp"
+#include "isaac/system/thread.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace isaac;
+
+TEST_CASE("Spatial queries find bodies through the broadphase")
+{
+  auto logger  = ServiceLocator<Logger>::register_service(Logger::ERROR);
+  auto physics = ServiceLocator<PhysicsServer2D>::register_service();
+  GameObject root;
+  // a 20x20 box with its corner at (100, 0)
+  auto& wall = root.make_child<GameObject>();
+  wall.set_position({100.f, 0.f});
+  auto& body = wall.make_component<CollisionObject2D>(Box2DShape{{20.f, 20.f}});
+  body.update(wall);
+
+  SUBCASE("raycast")
+  {
+    auto const hit = physics->raycast({{0.f, 10.f}, {200.f, 0.f}});
+    CHECK(hit.hit);
+    CHECK(hit.body == &body);
+    CHECK(hit.point.x == doctest::Approx(100.f));
+    CHECK(hit.normal.x == doctest::Approx(-1.f));
+    CHECK_FALSE(physics->raycast({{0.f, 50.f}, {200.f, 0.f}}).hit);
+  }
+
+  SUBCASE("shape cast")
+  {
+    auto const circle = Circle2DShape{5.f}.make_proxy({0.f, 10.f});
+    auto const hit    = physics->shape_cast({circle, {200.f, 0.f}});
+    CHECK(hit.hit);
+    CHECK(hit.body == &body);
+    CHECK(hit.fraction == doctest::Approx(95.f / 200.f).epsilon(0.01));
+  }
+
+  SUBCASE("overlap")
+  {
+    std::vector<CollisionBody2D*> bodies;
+    CHECK(physics->overlap({{90.f, 0.f}, {20.f, 20.f}}, bodies) == 1);
+    CHECK(bodies.front() == &body);
+    CHECK(physics->overlap({{0.f, 0.f}, {20.f, 20.f}}, bodies) == 0);
+  }
+
+  SUBCASE("batches")
+  {
+    JobSystem jobs{2};
+    // every other ray passes below the box
+    std::vector<Ray2D> rays;
+    for (int i = 0; i < 256; ++i) {
+      rays.push_back({{0.f, i % 2 == 0 ? 10.f : 50.f}, {200.f, 0.f}});
+    }
+    std::vector<CastHit2D> hits(rays.size());
+    physics->raycast(rays, hits, b2DefaultQueryFilter(), &jobs);
+    CHECK(std::ranges::count_if(hits, [](auto& h) { return h.hit; }) == 128);
+    CHECK(hits[0].body == &body);
+    CHECK_FALSE(hits[1].hit);
+
+    std::vector<sf::FloatRect> areas{{{90.f, 0.f}, {20.f, 20.f}},
+                                     {{0.f, 0.f}, {20.f, 20.f}}};
+    OverlapResults2D results{1};
+    physics->overlap(areas, results);
+    CHECK(results.size() == 2);
+    CHECK(results[0].size() == 1);
+    CHECK(results[0].front() == &body);
+    CHECK(results[1].empty());
+    CHECK_FALSE(results.truncated(0));
+  }
+}
@@ -0,0 +1,67 @@
+#include "doctest.h"
+
+#include "isaac/components/rigidbody_2d.hpp"
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/physics_2d.hpp"
+#include "isaac/physics/physics_settings.hpp"
+#include "isaac/system/logger.hpp"
+#include "isaac/system/service_locator.hpp"
+
+using namespace isaac;
+
+TEST_CASE("Sub-steps adapt to the step budget")
+{
+  auto logger = ServiceLocator<Logger>::register_service(Logger::ERROR);
+  PhysicsSettings settings;
+  settings.sub_steps          = 4;
+  settings.min_sub_steps      = 2;
+  settings.adaptive_sub_steps = true;
+  // every step overruns a negative budget
+  settings.step_budget = -1.f;
+  PhysicsServer2D physics{1, settings};
+  CHECK(physics.sub_steps() == 4);
+
+  for (int i = 0; i < 3; ++i) {
+    physics.update(1.f / 60.f);
+  }
+  CHECK(physics.sub_steps() == 2);
+
+  // new settings start again from the configured sub-steps
+  settings.step_budget = 1.f;
+  physics.set_settings(settings);
+  CHECK(physics.sub_steps() == 4);
+  settings.sub_steps = 0;
+  physics.set_settings(settings);
+  CHECK(physics.settings().sub_steps == 1);
+  CHECK(physics.settings().min_sub_steps == 1);
+}
+
+namespace {
+
+struct Body : RigidBody2D
+{
+  Body()
+      : RigidBody2D{Circle2DShape{1.f}}
+  {}
+  [[nodiscard]] b2BodyId id() const
+  {
+    return m_body_id;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Sleep threshold changes reach existing bodies")
+{
+  auto logger  = ServiceLocator<Logger>::register_service(Logger::ERROR);
+  auto physics = ServiceLocator<PhysicsServer2D>::register_service();
+  PhysicsSettings settings;
+  settings.sleep_threshold = 3.f;
+  physics->set_settings(settings);
+  Body const body;
+  CHECK(b2Body_GetSleepThreshold(body.id()) == doctest::Approx(3.f));
+
+  settings.sleep_threshold = 7.f;
+  physics->set_settings(settings);
+  CHECK(b2Body_GetSleepThreshold(body.id()) == doctest::Approx(7.f));
+}
@@ -0,0 +1,39 @@
+#include "doctest.h"
+
+#include "isaac/physics/collision_shape_2d.hpp"
+#include "isaac/physics/shape_cache.hpp"
+
+using namespace isaac;
+
+TEST_CASE("Identical shapes share their prototype")
+{
+  auto& cache       = ShapeCache::instance();
+  Circle2DShape a{10.f};
+  auto const before = cache.size();
+  Circle2DShape b{10.f};
+  CHECK(cache.size() == before);
+  CHECK(&a.shape_def() == &b.shape_def());
+  CHECK(b.get_radius() == 10.f);
+
+  Box2DShape box{{4.f, 2.f}};
+  CHECK(box.size().x == 4.f);
+  CHECK(box.size().y == 2.f);
+  CHECK(&box.shape_def() != &a.shape_def());
+
+  // flags select another prototype, leaving the shapes sharing the old one
+  b.set_sensor(true);
+  CHECK(b.shape_def().isSensor);
+  CHECK_FALSE(a.shape_def().isSensor);
+  b.set_sensor(false);
+  CHECK(&a.shape_def() == &b.shape_def());
+}
+
+TEST_CASE("Signed zero extents share their prototype")
+{
+  auto const positive = ShapeKey::of(ShapeKey::Type::box, {0.f, 1.f});
+  auto const negative = ShapeKey::of(ShapeKey::Type::box, {-0.f, 1.f});
+  REQUIRE(positive == negative);
+  CHECK(ShapeKeyHash{}(positive) == ShapeKeyHash{}(negative));
+  CHECK(&ShapeCache::instance().get(positive)
+        == &ShapeCache::instance().get(negative));
+}
@@ -0,0 +1,51 @@
+#include "doctest.h"
+
+#include "isaac/system/thread.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace isaac;
+
+TEST_CASE("parallel_for visits every item once")
+{
+  JobSystem jobs{4};
+  std::vector<std::atomic<int>> visits(1000);
+  jobs.parallel_for(static_cast<int>(visits.size()), 16,
+                    [&](int begin, int end) {
+                      for (auto i = begin; i < end; ++i) {
+                        visits[i].fetch_add(1);
+                      }
+                    });
+  for (auto const& visit : visits) {
+    CHECK(visit.load() == 1);
+  }
+}
+
+TEST_CASE("Jobs can wait on nested jobs")
+{
+  JobSystem jobs{3};
+  std::atomic<int> sum{0};
+  jobs.parallel_for(8, 1, [&](int begin, int end) {
+    for (auto i = begin; i < end; ++i) {
+      jobs.parallel_for(100, 10, [&](int b, int e) { sum.fetch_add(e - b); });
+    }
+  });
+  CHECK(sum.load() == 800);
+}
+
+TEST_CASE("wait rethrows the exception of a job")
+{
+  JobSystem jobs{2};
+  auto const throwing = [](int begin, int) {
+    if (begin == 3) {
+      throw std::runtime_error("job failed");
+    }
+  };
+  CHECK_THROWS_AS(jobs.parallel_for(8, 1, throwing), std::runtime_error);
+  // the pool is still usable afterwards
+  std::atomic<int> count{0};
+  jobs.parallel_for(8, 1, [&](int begin, int end) { count += end - begin; });
+  CHECK(count.load() == 8);
+}
@@ -0,0 +1,41 @@
+#include "doctest.h"
+
+#include "isaac/physics/transform.hpp"
+
+#include <SFML/System/Angle.hpp>
+
+#include <cstddef>
+
+using namespace isaac;
+
+TEST_CASE("compose matches the scalar product, tail included")
+{
+  // one block of four, then a scalar tail of three
+  constexpr std::size_t k_count = 7;
+  MatrixArray parents;
+  MatrixArray locals;
+  parents.resize(k_count);
+  locals.resize(k_count);
+  for (std::size_t i = 0; i < k_count; ++i) {
+    auto const f = static_cast<float>(i);
+    parents.set(i, Matrix2D::from({f, -2.f * f}, sf::degrees(15.f * f),
+                                  {1.f + f / 4.f, 2.f - f / 8.f}));
+    locals.set(i, Matrix2D::from({3.f - f, f / 2.f}, sf::degrees(-40.f + f),
+                                 {0.5f + f, 1.5f}));
+  }
+
+  MatrixArray out;
+  compose(parents, locals, out);
+  REQUIRE(out.size() == k_count);
+  for (std::size_t i = 0; i < k_count; ++i) {
+    CAPTURE(i);
+    auto const expected = parents.get(i) * locals.get(i);
+    auto const actual   = out.get(i);
+    CHECK(actual.a == doctest::Approx(expected.a));
+    CHECK(actual.b == doctest::Approx(expected.b));
+    CHECK(actual.c == doctest::Approx(expected.c));
+    CHECK(actual.d == doctest::Approx(expected.d));
+    CHECK(actual.tx == doctest::Approx(expected.tx));
+    CHECK(actual.ty == doctest::Approx(expected.ty));
+  }
+}
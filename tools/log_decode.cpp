@@ -0,0 +1,131 @@
+// Prints the records of a BinaryLogger file as text or JSON lines
+
+#include "isaac/system/binary_logger.hpp"
+
+#include <chrono>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace {
+
+// exposes the Logger formatting, so text output matches a Logger sink
+class Formatter : public isaac::Logger
+{
+ public:
+  using Logger::format_message;
+  using Logger::Logger;
+  using LoggerService::k_levels;
+};
+
+std::string json_escape(std::string_view text)
+{
+  std::string escaped;
+  escaped.reserve(text.size() + 2);
+  escaped += '"';
+  for (auto const c : text) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\t':
+      escaped += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        escaped += std::format("\\u{:04x}", static_cast<int>(c));
+      } else {
+        escaped += c;
+      }
+    }
+  }
+  escaped += '"';
+  return escaped;
+}
+
+std::string json_value(isaac::LogArg const& arg)
+{
+  return std::visit(
+      [](auto const& value) -> std::string {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, bool>) {
+          return value ? "true" : "false";
+        } else if constexpr (std::is_arithmetic_v<T>) {
+          return std::format("{}", value);
+        } else {
+          return json_escape(value);
+        }
+      },
+      arg);
+}
+
+void print_json(isaac::BinaryLogRecord const& record)
+{
+  using namespace std::chrono;
+  auto const ns = duration_cast<nanoseconds>(record.time.time_since_epoch());
+  std::string args;
+  for (auto const& arg : record.args) {
+    args += args.empty() ? "" : ",";
+    args += json_value(arg);
+  }
+  std::cout << std::format(
+      R"({{"time_ns":{},"level":"{}","template":{},"args":[{}],)"
+      R"("message":{}}})"
+      "\n",
+      ns.count(), Formatter::k_levels[record.level],
+      json_escape(record.fmt), args, json_escape(record.message()));
+}
+
+// times are shown in the local time zone of the reader
+void print_text(Formatter const& formatter,
+                isaac::BinaryLogRecord const& record)
+{
+  std::cout << formatter.format_message(record.message(), record.level,
+                                        record.time);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::string_view path;
+  bool json = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view const arg{argv[i]};
+    if (arg == "--json") {
+      json = true;
+    } else {
+      path = arg;
+    }
+  }
+  if (path.empty()) {
+    std::cerr << "usage: isaac-log-decode [--json] <file>\n";
+    return 2;
+  }
+
+  try {
+    isaac::BinaryLogReader reader{std::filesystem::path{path}};
+    Formatter const formatter{isaac::LoggerService::DEBUG};
+    while (auto const record = reader.next()) {
+      if (json) {
+        print_json(*record);
+      } else {
+        print_text(formatter, *record);
+      }
+    }
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}